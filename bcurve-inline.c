@@ -51,6 +51,8 @@ void BCurveSetCtrl(BCurve* const that, const int iCtrl,
 #endif
   // Set the values
   VecCopy(that->_ctrl[iCtrl], v);
+  // Invalidate the cached data
+  _BCurveInvalidateCache(that);
 }
 
 // Get a copy of the iCtrl-th control point
@@ -142,6 +144,92 @@ int BCurveGetOrder(const BCurve* const that) {
   return that->_order;
 }
 
+// Return true if the control points of the BCurve are packed (cf 
+// BCurveCreatePacked and the segments of SCurve), false else
+#if BUILDMODE != 0
+static inline
+#endif 
+bool BCurveIsPacked(const BCurve* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (that->_packed == true && _BCurveIsStrided(that) == false) {
+    BCurveErr->_type = PBErrTypeInvalidData;
+    sprintf(BCurveErr->_msg, "'that' is packed but not strided");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  return that->_packed;
+}
+
+// Set the flag memorizing if the BCurve 'that' is evaluated with its 
+// coefficients in power basis to 'flag'
+// Not thread-safe once the flag is set: the first evaluation after a
+// modification of 'that' fills the coefficients through the const 
+// pointer
+#if BUILDMODE != 0
+static inline
+#endif 
+void BCurveSetUsePowerBasis(BCurve* const that, const bool flag) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  that->_usePowerBasis = flag;
+  // If the power basis is not used anymore, release the coefficients
+  if (flag == false)
+    _BCurveInvalidateCache(that);
+}
+
+// Return the flag memorizing if the BCurve 'that' is evaluated with 
+// its coefficients in power basis
+#if BUILDMODE != 0
+static inline
+#endif 
+bool BCurveGetUsePowerBasis(const BCurve* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  return that->_usePowerBasis;
+}
+
+// Invalidate the data cached by the BCurve 'that'
+// Must be called each time the control points are modified
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveInvalidateCache(BCurve* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Release the coefficients in power basis, they will be calculated 
+  // again at next evaluation if needed
+  if (that->_powerBasis != NULL) {
+    free(that->_powerBasis);
+    that->_powerBasis = NULL;
+  }
+  // Release the bounding boxes and the center
+  free(that->_bound);
+  that->_bound = NULL;
+  free(that->_tightBound);
+  that->_tightBound = NULL;
+  VecFree(&(that->_center));
+}
+
 // Get the dimension of the BCurve
 #if BUILDMODE != 0
 static inline
@@ -180,6 +268,8 @@ float BCurveGetApproxLen(const BCurve* const that) {
 }
 
 // Return the center of the BCurve (average of control points)
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
 #if BUILDMODE != 0
 static inline
 #endif 
@@ -191,14 +281,18 @@ VecFloat* BCurveGetCenter(const BCurve* const that) {
     PBErrCatch(BCurveErr);
   }
 #endif
-  // Sum all the control points
-  VecFloat* center = VecClone(that->_ctrl[that->_order]);
-  for (int iCtrl = that->_order; iCtrl--;)
-    VecOp(center, 1.0, that->_ctrl[iCtrl], 1.0);
-  // Get the average
-  VecScale(center, 1.0 / (float)(that->_order + 1));
-  // Return the result
-  return center;
+  // If the center is not in the cache
+  if (that->_center == NULL) {
+    // Sum all the control points
+    VecFloat* center = VecClone(that->_ctrl[that->_order]);
+    for (int iCtrl = that->_order; iCtrl--;)
+      VecOp(center, 1.0, that->_ctrl[iCtrl], 1.0);
+    // Get the average
+    VecScale(center, 1.0 / (float)(that->_order + 1));
+    ((BCurve*)that)->_center = center;
+  }
+  // Return a copy of the cached center
+  return VecClone(that->_center);
 }
 
 // Rotate the curve CCW by 'theta' radians relatively to the origin
@@ -224,6 +318,8 @@ void BCurveRotOrigin(BCurve* const that, const float theta) {
   for (int iCtrl = that->_order + 1; iCtrl--;)
     // Rotate the control point
     VecRot(that->_ctrl[iCtrl], theta);
+  // Invalidate the cached data
+  _BCurveInvalidateCache(that);
 }
 
 // Rotate the curve CCW by 'theta' radians relatively to its 
@@ -254,6 +350,8 @@ void BCurveRotStart(BCurve* const that, const float theta) {
     // Translate back the control point
     VecOp(that->_ctrl[iCtrl], 1.0, that->_ctrl[0], 1.0);
   }
+  // Invalidate the cached data
+  _BCurveInvalidateCache(that);
 }
 
 // Rotate the curve CCW by 'theta' radians relatively to its 
@@ -288,6 +386,8 @@ void BCurveRotCenter(BCurve* const that, const float theta) {
   }
   // Free memory
   VecFree(&center);
+  // Invalidate the cached data
+  _BCurveInvalidateCache(that);
 }
 
 // Scale the curve by 'v' relatively to the origin
@@ -321,6 +421,8 @@ void _BCurveScaleOriginVector(BCurve* const that,
     for (long dim = 0; dim < VecGetDim(ctrl); ++dim)
       VecSet(ctrl, dim, VecGet(ctrl, dim) * VecGet(v, dim));
   }
+  // Invalidate the cached data
+  _BCurveInvalidateCache(that);
 }
 
 // Scale the curve by 'c' relatively to the origin
@@ -339,6 +441,8 @@ void _BCurveScaleOriginScalar(BCurve* const that, const float c) {
   for (int iCtrl = that->_order + 1; iCtrl--;)
     // Scale the control point
     VecScale(that->_ctrl[iCtrl], c);
+  // Invalidate the cached data
+  _BCurveInvalidateCache(that);
 }
 
 // Scale the curve by 'v' relatively to its origin
@@ -377,6 +481,8 @@ void _BCurveScaleStartVector(BCurve* const that,
     // Translate back the control point
     VecOp(ctrl, 1.0, that->_ctrl[0], 1.0);
   }
+  // Invalidate the cached data
+  _BCurveInvalidateCache(that);
 }
 
 // Scale the curve by 'c' relatively to its origin
@@ -402,6 +508,8 @@ void _BCurveScaleStartScalar(BCurve* const that, const float c) {
     // Translate back the control point
     VecOp(ctrl, 1.0, that->_ctrl[0], 1.0);
   }
+  // Invalidate the cached data
+  _BCurveInvalidateCache(that);
 }
 
 // Scale the curve by 'v' relatively to its center
@@ -443,6 +551,8 @@ void _BCurveScaleCenterVector(BCurve* const that,
   }
   // Free memory
   VecFree(&center);
+  // Invalidate the cached data
+  _BCurveInvalidateCache(that);
 }
 
 // Scale the curve by 'c' relatively to its center
@@ -471,6 +581,8 @@ void _BCurveScaleCenterScalar(BCurve* const that, const float c) {
   }
   // Free memory
   VecFree(&center);
+  // Invalidate the cached data
+  _BCurveInvalidateCache(that);
 }
 
 // Translate the curve by 'v'
@@ -500,6 +612,465 @@ void _BCurveTranslate(BCurve* const that, const VecFloat* const v) {
   for (int iCtrl = that->_order + 1; iCtrl--;)
     // Translate the control point
     VecOp(that->_ctrl[iCtrl], 1.0, v, 1.0);
+  // Invalidate the cached data
+  _BCurveInvalidateCache(that);
+}
+
+// Set the weights 'w' of the control points of a BCurve of order 1
+// at parameter 't'
+// 'w' must be allocated by the user with at least 2 floats
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetWeightOrder1(const float t, float* const w) {
+#if BUILDMODE == 0
+  if (w == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'w' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Calculate the weights
+  w[0] = 1.0 - t;
+  w[1] = t;
+}
+
+// Set the weights 'w' of the control points of a BCurve of order 2
+// at parameter 't'
+// 'w' must be allocated by the user with at least 3 floats
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetWeightOrder2(const float t, float* const w) {
+#if BUILDMODE == 0
+  if (w == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'w' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Calculate the weights by the recurrence of BCurveGetWeightCtrlPt,
+  // unrolled
+  double s = 1.0 - t;
+  float a0 = s;
+  w[2] = t * t;
+  w[1] = s * t + t * a0;
+  w[0] = s * a0;
+}
+
+// Set the weights 'w' of the control points of a BCurve of order 3
+// at parameter 't'
+// 'w' must be allocated by the user with at least 4 floats
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetWeightOrder3(const float t, float* const w) {
+#if BUILDMODE == 0
+  if (w == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'w' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Calculate the weights by the recurrence of BCurveGetWeightCtrlPt,
+  // unrolled
+  double s = 1.0 - t;
+  float a0 = s;
+  float b2 = t * t;
+  float b1 = s * t + t * a0;
+  float b0 = s * a0;
+  w[3] = t * b2;
+  w[2] = s * b2 + t * b1;
+  w[1] = s * b1 + t * b0;
+  w[0] = s * b0;
+}
+
+// Set the weights 'w' of the control points of a BCurve of order 
+// 'order' at parameter 't' with the generic recurrence
+// 'w' must be allocated by the user with at least 'order' + 1 floats
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetWeightOrderN(const int order, const float t, 
+  float* const w) {
+#if BUILDMODE == 0
+  if (w == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'w' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  w[0] = 1.0;
+  for (int sub = 1; sub <= order; ++sub) {
+    w[sub] = t * w[sub - 1];
+    for (int k = sub - 1; k > 0; --k)
+      w[k] = (1.0 - t) * w[k] + t * w[k - 1];
+    w[0] = (1.0 - t) * w[0];
+  }
+}
+
+// Get the value of the BCurve 'that' of order 1 and dimension 2 at 
+// parameter 'u' and store it in 'res' with a stride of 'stride'
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetOrder1Dim2(const BCurve* const that, const float u, 
+  float* const res, const long stride) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (that->_order != 1 || that->_dim != 2) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'that' is invalid (order %d==1, dim %d==2)",
+      that->_order, that->_dim);
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Declare a variable for the parameter complement, and variables
+  // for the intermediate values of the De Casteljau algorithm
+  double s = 1.0 - u;
+  // Get the values of the control points
+  const float* c0 = that->_ctrl[0]->_val;
+  const float* c1 = that->_ctrl[1]->_val;
+  // Unrolled De Casteljau algorithm in each dimension
+  res[0] = s * c0[0] + u * c1[0];
+  res[stride] = s * c0[1] + u * c1[1];
+}
+
+// Get the value of the BCurve 'that' of order 1 and dimension 3 at 
+// parameter 'u' and store it in 'res' with a stride of 'stride'
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetOrder1Dim3(const BCurve* const that, const float u, 
+  float* const res, const long stride) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (that->_order != 1 || that->_dim != 3) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'that' is invalid (order %d==1, dim %d==3)",
+      that->_order, that->_dim);
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Declare a variable for the parameter complement, and variables
+  // for the intermediate values of the De Casteljau algorithm
+  double s = 1.0 - u;
+  // Get the values of the control points
+  const float* c0 = that->_ctrl[0]->_val;
+  const float* c1 = that->_ctrl[1]->_val;
+  // Unrolled De Casteljau algorithm in each dimension
+  res[0] = s * c0[0] + u * c1[0];
+  res[stride] = s * c0[1] + u * c1[1];
+  res[2 * stride] = s * c0[2] + u * c1[2];
+}
+
+// Get the value of the BCurve 'that' of order 2 and dimension 2 at 
+// parameter 'u' and store it in 'res' with a stride of 'stride'
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetOrder2Dim2(const BCurve* const that, const float u, 
+  float* const res, const long stride) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (that->_order != 2 || that->_dim != 2) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'that' is invalid (order %d==2, dim %d==2)",
+      that->_order, that->_dim);
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Declare a variable for the parameter complement, and variables
+  // for the intermediate values of the De Casteljau algorithm
+  double s = 1.0 - u;
+  float a0, a1;
+  // Get the values of the control points
+  const float* c0 = that->_ctrl[0]->_val;
+  const float* c1 = that->_ctrl[1]->_val;
+  const float* c2 = that->_ctrl[2]->_val;
+  // Unrolled De Casteljau algorithm in each dimension
+  a0 = s * c0[0] + u * c1[0];
+  a1 = s * c1[0] + u * c2[0];
+  res[0] = s * a0 + u * a1;
+  a0 = s * c0[1] + u * c1[1];
+  a1 = s * c1[1] + u * c2[1];
+  res[stride] = s * a0 + u * a1;
+}
+
+// Get the value of the BCurve 'that' of order 2 and dimension 3 at 
+// parameter 'u' and store it in 'res' with a stride of 'stride'
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetOrder2Dim3(const BCurve* const that, const float u, 
+  float* const res, const long stride) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (that->_order != 2 || that->_dim != 3) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'that' is invalid (order %d==2, dim %d==3)",
+      that->_order, that->_dim);
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Declare a variable for the parameter complement, and variables
+  // for the intermediate values of the De Casteljau algorithm
+  double s = 1.0 - u;
+  float a0, a1;
+  // Get the values of the control points
+  const float* c0 = that->_ctrl[0]->_val;
+  const float* c1 = that->_ctrl[1]->_val;
+  const float* c2 = that->_ctrl[2]->_val;
+  // Unrolled De Casteljau algorithm in each dimension
+  a0 = s * c0[0] + u * c1[0];
+  a1 = s * c1[0] + u * c2[0];
+  res[0] = s * a0 + u * a1;
+  a0 = s * c0[1] + u * c1[1];
+  a1 = s * c1[1] + u * c2[1];
+  res[stride] = s * a0 + u * a1;
+  a0 = s * c0[2] + u * c1[2];
+  a1 = s * c1[2] + u * c2[2];
+  res[2 * stride] = s * a0 + u * a1;
+}
+
+// Get the value of the BCurve 'that' of order 3 and dimension 2 at 
+// parameter 'u' and store it in 'res' with a stride of 'stride'
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetOrder3Dim2(const BCurve* const that, const float u, 
+  float* const res, const long stride) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (that->_order != 3 || that->_dim != 2) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'that' is invalid (order %d==3, dim %d==2)",
+      that->_order, that->_dim);
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Declare a variable for the parameter complement, and variables
+  // for the intermediate values of the De Casteljau algorithm
+  double s = 1.0 - u;
+  float a0, a1, a2;
+  // Get the values of the control points
+  const float* c0 = that->_ctrl[0]->_val;
+  const float* c1 = that->_ctrl[1]->_val;
+  const float* c2 = that->_ctrl[2]->_val;
+  const float* c3 = that->_ctrl[3]->_val;
+  // Unrolled De Casteljau algorithm in each dimension
+  a0 = s * c0[0] + u * c1[0];
+  a1 = s * c1[0] + u * c2[0];
+  a2 = s * c2[0] + u * c3[0];
+  a0 = s * a0 + u * a1;
+  a1 = s * a1 + u * a2;
+  res[0] = s * a0 + u * a1;
+  a0 = s * c0[1] + u * c1[1];
+  a1 = s * c1[1] + u * c2[1];
+  a2 = s * c2[1] + u * c3[1];
+  a0 = s * a0 + u * a1;
+  a1 = s * a1 + u * a2;
+  res[stride] = s * a0 + u * a1;
+}
+
+// Get the value of the BCurve 'that' of order 3 and dimension 3 at 
+// parameter 'u' and store it in 'res' with a stride of 'stride'
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetOrder3Dim3(const BCurve* const that, const float u, 
+  float* const res, const long stride) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (that->_order != 3 || that->_dim != 3) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'that' is invalid (order %d==3, dim %d==3)",
+      that->_order, that->_dim);
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Declare a variable for the parameter complement, and variables
+  // for the intermediate values of the De Casteljau algorithm
+  double s = 1.0 - u;
+  float a0, a1, a2;
+  // Get the values of the control points
+  const float* c0 = that->_ctrl[0]->_val;
+  const float* c1 = that->_ctrl[1]->_val;
+  const float* c2 = that->_ctrl[2]->_val;
+  const float* c3 = that->_ctrl[3]->_val;
+  // Unrolled De Casteljau algorithm in each dimension
+  a0 = s * c0[0] + u * c1[0];
+  a1 = s * c1[0] + u * c2[0];
+  a2 = s * c2[0] + u * c3[0];
+  a0 = s * a0 + u * a1;
+  a1 = s * a1 + u * a2;
+  res[0] = s * a0 + u * a1;
+  a0 = s * c0[1] + u * c1[1];
+  a1 = s * c1[1] + u * c2[1];
+  a2 = s * c2[1] + u * c3[1];
+  a0 = s * a0 + u * a1;
+  a1 = s * a1 + u * a2;
+  res[stride] = s * a0 + u * a1;
+  a0 = s * c0[2] + u * c1[2];
+  a1 = s * c1[2] + u * c2[2];
+  a2 = s * c2[2] + u * c3[2];
+  a0 = s * a0 + u * a1;
+  a1 = s * a1 + u * a2;
+  res[2 * stride] = s * a0 + u * a1;
+}
+
+// Get the value of the BCurve 'that' at parameter 'u' with the 
+// unrolled evaluation specialized for its order and dimension and 
+// store it in 'res' with a stride of 'stride'
+// Return true if there is such a specialization (order 1, 2 or 3 
+// and dimension 2 or 3), false else (and 'res' is left unchanged)
+#if BUILDMODE != 0
+static inline
+#endif 
+bool _BCurveGetSpecialized(const BCurve* const that, const float u, 
+  float* const res, const long stride) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Dispatch according to the order and dimension
+  if (that->_dim == 2) {
+    switch (that->_order) {
+      case 1:
+        _BCurveGetOrder1Dim2(that, u, res, stride);
+        return true;
+      case 2:
+        _BCurveGetOrder2Dim2(that, u, res, stride);
+        return true;
+      case 3:
+        _BCurveGetOrder3Dim2(that, u, res, stride);
+        return true;
+      default:
+        return false;
+    }
+  } else if (that->_dim == 3) {
+    switch (that->_order) {
+      case 1:
+        _BCurveGetOrder1Dim3(that, u, res, stride);
+        return true;
+      case 2:
+        _BCurveGetOrder2Dim3(that, u, res, stride);
+        return true;
+      case 3:
+        _BCurveGetOrder3Dim3(that, u, res, stride);
+        return true;
+      default:
+        return false;
+    }
+  }
+  // There is no specialization
+  return false;
+}
+
+// Add to the normal equations of the least squares fitting of 
+// control points (cf _BCurveFitCtrl) the equation 
+// sum_k('coeff'[k].C['first' + k]) = 'target', where C are the 
+// control points of dimension 'dim', the first one being fixed to
+// 'head' and the last one ('nb' + 1) being fixed to 'tail'
+// 'band' is the upper band of half width 'hw' of the matrix and 'rhs'
+// the right hand sides, one row per unknown control point
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveFitAccumulate(double* const band, double* const rhs, 
+  const int hw, const int nb, const int dim, const int first, 
+  const int nbCoeff, const float* const coeff, 
+  const float* const target, const float* const head, 
+  const float* const tail) {
+  // Remove the contribution of the fixed control points from the 
+  // target
+  float res[dim];
+  memcpy(res, target, sizeof(float) * dim);
+  for (int k = nbCoeff; k--;) {
+    int iCtrl = first + k;
+    if (iCtrl == 0 || iCtrl == nb + 1) {
+      const float* fixed = (iCtrl == 0 ? head : tail);
+      for (int iDim = dim; iDim--;)
+        res[iDim] -= coeff[k] * fixed[iDim];
+    }
+  }
+  // Accumulate the products of coefficients of the unknown control
+  // points
+  for (int k = nbCoeff; k--;) {
+    int i = first + k - 1;
+    if (i < 0 || i >= nb)
+      continue;
+    for (int iDim = dim; iDim--;)
+      rhs[i * dim + iDim] += coeff[k] * res[iDim];
+    for (int l = k; l < nbCoeff; ++l) {
+      int j = first + l - 1;
+      if (j >= nb)
+        break;
+      band[i * (hw + 1) + j - i] += coeff[k] * coeff[l];
+    }
+  }
 }
 
 // -------------- SCurve
@@ -570,10 +1141,12 @@ VecFloat* SCurveGetCtrl(const SCurve* const that, const int iCtrl) {
     PBErrCatch(BCurveErr);
   }
 #endif
-  return VecClone(GSetGet(&(that->_ctrl), iCtrl));
+  return VecClone(that->_ctrlArr[that->_iHead * that->_order + iCtrl]);
 }
 
 // Get the 'iCtrl'-th control point
+// The pointer is invalidated by SCurveAddSegHead and SCurveAddSegTail,
+// which may move the segments and control points in memory
 #if BUILDMODE != 0
 static inline
 #endif 
@@ -591,7 +1164,7 @@ const VecFloat* SCurveCtrl(const SCurve* const that, const int iCtrl) {
     PBErrCatch(BCurveErr);
   }
 #endif
-  return (const VecFloat*)GSetGet(&(that->_ctrl), iCtrl);
+  return that->_ctrlArr[that->_iHead * that->_order + iCtrl];
 }
 
 // Get the 'iDim'-th value of the 'iCtrl'-th control point
@@ -624,6 +1197,8 @@ float SCurveCtrlGet(const SCurve* const that, const int iCtrl,
 }
 
 // Get the set of control point of the SCurve 'that'
+// The pointers in the GSet and its iterators are invalidated by 
+// SCurveAddSegHead and SCurveAddSegTail
 #if BUILDMODE != 0
 static inline
 #endif 
@@ -656,10 +1231,12 @@ BCurve* SCurveGetSeg(const SCurve* const that, const int iSeg) {
     PBErrCatch(BCurveErr);
   }
 #endif
-  return BCurveClone((BCurve*)GSetGet(&(that->_seg), iSeg));
+  return BCurveClone(that->_segArr + that->_iHead + iSeg);
 }
 
 // Get the 'iSeg'-th segment
+// The pointer is invalidated by SCurveAddSegHead and SCurveAddSegTail,
+// which may move the segments and control points in memory
 #if BUILDMODE != 0
 static inline
 #endif 
@@ -677,10 +1254,12 @@ const BCurve* SCurveSeg(const SCurve* const that, const int iSeg) {
     PBErrCatch(BCurveErr);
   }
 #endif
-  return (BCurve*)GSetGet(&(that->_seg), iSeg);
+  return that->_segArr + that->_iHead + iSeg;
 }
 
 // Get the GSet of segments of the SCurve 'that'
+// The pointers in the GSet and its iterators are invalidated by 
+// SCurveAddSegHead and SCurveAddSegTail
 #if BUILDMODE != 0
 static inline
 #endif 
@@ -696,6 +1275,8 @@ const GSetBCurve* SCurveSegs(const SCurve* const that) {
 }
 
 // Return the center of the SCurve (average of control points)
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
 #if BUILDMODE != 0
 static inline
 #endif 
@@ -707,16 +1288,20 @@ VecFloat* SCurveGetCenter(const SCurve* const that) {
     PBErrCatch(BCurveErr);
   }
 #endif
-  // Sum all the control points
-  VecFloat* center = VecFloatCreate(that->_dim);
-  GSetIterForward iter = GSetIterForwardCreateStatic(&(that->_ctrl));
-  do {
-    VecOp(center, 1.0, (VecFloat*)GSetIterGet(&iter), 1.0);
-  } while (GSetIterStep(&iter));
-  // Get the average
-  VecScale(center, 1.0 / (float)GSetNbElem(&(that->_ctrl)));
-  // Return the result
-  return center;
+  // If the center is not in the cache
+  if (that->_center == NULL) {
+    // Sum all the control points
+    VecFloat* center = VecFloatCreate(that->_dim);
+    GSetIterForward iter = GSetIterForwardCreateStatic(&(that->_ctrl));
+    do {
+      VecOp(center, 1.0, (VecFloat*)GSetIterGet(&iter), 1.0);
+    } while (GSetIterStep(&iter));
+    // Get the average
+    VecScale(center, 1.0 / (float)GSetNbElem(&(that->_ctrl)));
+    ((SCurve*)that)->_center = center;
+  }
+  // Return a copy of the cached center
+  return VecClone(that->_center);
 }
 
 // Return the max value for the parameter 'u' of SCurveGet
@@ -768,6 +1353,9 @@ void SCurveRotOrigin(SCurve* const that, const float theta) {
     // Rotate the control point
     VecRot((VecFloat*)GSetIterGet(&iter), theta);
   } while (GSetIterStep(&iter));
+  // Invalidate the cached data
+  _SCurveInvalidateSegCache(that, -1);
+  _SCurveInvalidateCache(that);
 }
 
 // Rotate the curve CCW by 'theta' radians relatively to its 
@@ -797,6 +1385,9 @@ void SCurveRotStart(SCurve* const that, const float theta) {
       VecOp(ctrl, 1.0, origin, 1.0);
     } while (GSetIterStep(&iter));
   }
+  // Invalidate the cached data
+  _SCurveInvalidateSegCache(that, -1);
+  _SCurveInvalidateCache(that);
 }
 
 // Rotate the curve CCW by 'theta' radians relatively to its 
@@ -827,6 +1418,9 @@ void SCurveRotCenter(SCurve* const that, const float theta) {
   } while (GSetIterStep(&iter));
   // Free memory
   VecFree(&center);
+  // Invalidate the cached data
+  _SCurveInvalidateSegCache(that, -1);
+  _SCurveInvalidateCache(that);
 }
 
 // Scale the curve by 'v' relatively to the origin
@@ -851,6 +1445,9 @@ void _SCurveScaleOriginVector(SCurve* const that,
     for (int iDim = SCurveGetDim(that); iDim--;)
       VecSet(ctrl, iDim, VecGet(ctrl, iDim) * VecGet(v, iDim));
   } while (GSetIterStep(&iter));
+  // Invalidate the cached data
+  _SCurveInvalidateSegCache(that, -1);
+  _SCurveInvalidateCache(that);
 }
 
 // Scale the curve by 'c' relatively to the origin
@@ -872,6 +1469,9 @@ void _SCurveScaleOriginScalar(SCurve* const that, const float c) {
     // Scale the control point
     VecScale((VecFloat*)GSetIterGet(&iter), c);
   } while (GSetIterStep(&iter));
+  // Invalidate the cached data
+  _SCurveInvalidateSegCache(that, -1);
+  _SCurveInvalidateCache(that);
 }
 
 // Scale the curve by 'v' relatively to its origin
@@ -914,6 +1514,9 @@ void _SCurveScaleStartVector(SCurve* const that,
       VecOp(ctrl, 1.0, origin, 1.0);
     } while (GSetIterStep(&iter));
   }
+  // Invalidate the cached data
+  _SCurveInvalidateSegCache(that, -1);
+  _SCurveInvalidateCache(that);
 }
 
 // Scale the curve by 'c' relatively to its origin
@@ -943,6 +1546,9 @@ void _SCurveScaleStartScalar(SCurve* const that, const float c) {
       VecOp(ctrl, 1.0, origin, 1.0);
     } while (GSetIterStep(&iter));
   }
+  // Invalidate the cached data
+  _SCurveInvalidateSegCache(that, -1);
+  _SCurveInvalidateCache(that);
 }
 
 // Scale the curve by 'v' relatively to its center
@@ -985,6 +1591,9 @@ void _SCurveScaleCenterVector(SCurve* const that,
   } while (GSetIterStep(&iter));
   // Free memory
   VecFree(&center);
+  // Invalidate the cached data
+  _SCurveInvalidateSegCache(that, -1);
+  _SCurveInvalidateCache(that);
 }
 
 // Scale the curve by 'c' relatively to its center
@@ -1014,6 +1623,9 @@ void _SCurveScaleCenterScalar(SCurve* const that, const float c) {
   } while (GSetIterStep(&iter));
   // Free memory
   VecFree(&center);
+  // Invalidate the cached data
+  _SCurveInvalidateSegCache(that, -1);
+  _SCurveInvalidateCache(that);
 }
 
 // Translate the curve by 'v'
@@ -1044,37 +1656,67 @@ void _SCurveTranslate(SCurve* const that, const VecFloat* const v) {
   do {
     VecOp((VecFloat*)GSetIterGet(&iter), 1.0, v, 1.0);
   } while (GSetIterStep(&iter));
+  // Invalidate the cached data
+  _SCurveInvalidateSegCache(that, -1);
+  _SCurveInvalidateCache(that);
 }
 
-// Get the value of the SCurve at paramater 'u'
-// The value is equal to the value of the floor(u)-th segment at
-// value (u - floor(u))
+// Get the index of the segment of the SCurve 'that' at paramater 'u'
+// and set 'uloc' to the value of the paramater local to this segment
 // u can extend beyond [0.0, _nbSeg]
 #if BUILDMODE != 0
 static inline
 #endif 
-VecFloat* SCurveGet(const SCurve* const that, const float u) {
+int SCurveGetSegIndex(const SCurve* const that, const float u, 
+  float* const uloc) {
 #if BUILDMODE == 0
   if (that == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
     sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
+  if (uloc == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'uloc' is null");
+    PBErrCatch(BCurveErr);
+  }
 #endif
   // Declare a variable to memorize the relevant segment
   int iSeg = 0;
-  // Declare a variable to memorize the local parameter value
-  float uloc = u;
   // Get the segment the corresponding to 'u'
   if (u < 0.0) {
     iSeg = 0;
+    *uloc = u;
   } else if (u >= that->_nbSeg) {
     iSeg = that->_nbSeg - 1;
-    uloc = u - (float)(that->_nbSeg - 1);
+    *uloc = u - (float)(that->_nbSeg - 1);
   } else { 
     iSeg = (int)floor(u);
-    uloc = u - (float)iSeg;
+    *uloc = u - (float)iSeg;
   }
+  // Return the index of the segment
+  return iSeg;
+}
+
+// Get the value of the SCurve at paramater 'u'
+// The value is equal to the value of the floor(u)-th segment at
+// value (u - floor(u))
+// u can extend beyond [0.0, _nbSeg]
+#if BUILDMODE != 0
+static inline
+#endif 
+VecFloat* SCurveGet(const SCurve* const that, const float u) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Get the segment corresponding to 'u' and the local parameter
+  // value in this segment
+  float uloc = 0.0;
+  int iSeg = SCurveGetSegIndex(that, u, &uloc);
   // Get the value of the BCurve
   return BCurveGet(SCurveSeg(that, iSeg), uloc);
 }
@@ -1104,6 +1746,61 @@ float SCurveGetApproxLen(const SCurve* const that) {
   return length;
 }
 
+// Free the cached data of the SCurve 'that'
+// Must be called each time the control points of the SCurve are 
+// modified
+#if BUILDMODE != 0
+static inline
+#endif 
+void _SCurveInvalidateCache(SCurve* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Free the arc length table
+  free(that->_arcLen);
+  that->_arcLen = NULL;
+  // Flag the bounding volume hierarchy to be refitted
+  that->_bvhDirty = true;
+  // Free the bounding boxes and the center
+  free(that->_bound);
+  that->_bound = NULL;
+  free(that->_tightBound);
+  that->_tightBound = NULL;
+  VecFree(&(that->_center));
+}
+
+// Free the cached data of the segments of the SCurve 'that' using 
+// the 'iCtrl'-th control point, or of all the segments if 'iCtrl' is
+// negative
+// Must be called each time the control points of the SCurve are 
+// modified
+#if BUILDMODE != 0
+static inline
+#endif 
+void _SCurveInvalidateSegCache(SCurve* const that, const int iCtrl) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Get the range of segments using the control point
+  int first = 0;
+  int last = that->_nbSeg - 1;
+  if (iCtrl >= 0 && that->_order > 0) {
+    first = MAX(0, (iCtrl - 1) / that->_order);
+    last = MIN(last, iCtrl / that->_order);
+  }
+  // Free the cached data of the segments
+  for (int iSeg = first; iSeg <= last; ++iSeg)
+    _BCurveInvalidateCache(that->_segArr + that->_iHead + iSeg);
+}
+
 // Set the 'iCtrl'-th control point to 'v'
 #if BUILDMODE != 0
 static inline
@@ -1128,7 +1825,10 @@ void SCurveSetCtrl(SCurve* const that, const int iCtrl,
     PBErrCatch(BCurveErr);
   }
 #endif
-  VecCopy((VecFloat*)GSetGet(&(that->_ctrl), iCtrl), v);
+  VecCopy(that->_ctrlArr[that->_iHead * that->_order + iCtrl], v);
+  // Invalidate the cached data
+  _SCurveInvalidateSegCache(that, iCtrl);
+  _SCurveInvalidateCache(that);
 }
 
 // Set the 'iDim'-th value of the 'iCtrl'-th control point to 'v'
@@ -1156,7 +1856,10 @@ void SCurveCtrlSet(SCurve* const that, const int iCtrl, const int iDim,
     PBErrCatch(BCurveErr);
   }
 #endif
-  VecSet((VecFloat*)GSetGet(&(that->_ctrl), iCtrl), iDim, v);
+  VecSet(that->_ctrlArr[that->_iHead * that->_order + iCtrl], iDim, v);
+  // Invalidate the cached data
+  _SCurveInvalidateSegCache(that, iCtrl);
+  _SCurveInvalidateCache(that);
 }
 
 
@@ -1224,6 +1927,9 @@ void SCurveIterSetCurve(SCurveIter* const that,
   }
 #endif  
   that->_curve = curve;
+  that->_iSeg = SCurveGetSegIndex(curve, that->_curPos, &(that->_uloc));
+  if (that->_byLength == true)
+    that->_curLen = SCurveGetLengthAtParam(curve, that->_curPos);
 }
 
 // Set the delta of the SCurveIter 'that' to 'delta'
@@ -1276,6 +1982,41 @@ float SCurveIterGetDelta(const SCurveIter* const that) {
   return that->_delta;  
 }
 
+// Set the flag of the SCurveIter 'that' to step by constant arc length
+// to 'byLength'
+// If true, the delta is a length instead of a parameter
+#if BUILDMODE != 0
+static inline
+#endif 
+void SCurveIterSetByLength(SCurveIter* const that, const bool byLength) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  that->_byLength = byLength;
+  if (byLength == true)
+    that->_curLen = SCurveGetLengthAtParam(that->_curve, that->_curPos);
+}
+
+// Return true if the SCurveIter 'that' steps by constant arc length, 
+// false else
+#if BUILDMODE != 0
+static inline
+#endif 
+bool SCurveIterIsByLength(const SCurveIter* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  return that->_byLength;
+}
+
 // Init the SCurveIter 'that'
 #if BUILDMODE != 0
 static inline
@@ -1289,6 +2030,9 @@ void SCurveIterInit(SCurveIter* const that) {
   }
 #endif
   that->_curPos = 0.0;
+  that->_iSeg = 0;
+  that->_uloc = 0.0;
+  that->_curLen = 0.0;
 }
 
 // Step the SCurveIter 'that'
@@ -1304,12 +2048,24 @@ bool SCurveIterStep(SCurveIter* const that) {
     PBErrCatch(BCurveErr);
   }
 #endif
-  if (that->_curPos > 
-    SCurveGetMaxU(SCurveIterCurve(that)) - PBMATH_EPSILON)
-    return false;
-  that->_curPos += that->_delta;
-  if (that->_curPos > SCurveGetMaxU(SCurveIterCurve(that)))
-    that->_curPos = SCurveGetMaxU(SCurveIterCurve(that));
+  // If stepping by arc length
+  if (that->_byLength == true) {
+    float len = SCurveGetLength(that->_curve);
+    if (that->_curLen > len - PBMATH_EPSILON)
+      return false;
+    that->_curLen += that->_delta;
+    if (that->_curLen > len)
+      that->_curLen = len;
+    that->_curPos = SCurveGetParamAtLength(that->_curve, that->_curLen);
+  } else {
+    float maxU = SCurveGetMaxU(that->_curve);
+    if (that->_curPos > maxU - PBMATH_EPSILON)
+      return false;
+    that->_curPos += that->_delta;
+    if (that->_curPos > maxU)
+      that->_curPos = maxU;
+  }
+  _SCurveIterUpdateSeg(that);
   return true;
 }
 
@@ -1326,11 +2082,22 @@ bool SCurveIterStepP(SCurveIter* const that) {
     PBErrCatch(BCurveErr);
   }
 #endif
-  if (that->_curPos < PBMATH_EPSILON)
-    return false;
-  that->_curPos -= that->_delta;
-  if (that->_curPos < 0.0)
-    that->_curPos = 0.0;
+  // If stepping by arc length
+  if (that->_byLength == true) {
+    if (that->_curLen < PBMATH_EPSILON)
+      return false;
+    that->_curLen -= that->_delta;
+    if (that->_curLen < 0.0)
+      that->_curLen = 0.0;
+    that->_curPos = SCurveGetParamAtLength(that->_curve, that->_curLen);
+  } else {
+    if (that->_curPos < PBMATH_EPSILON)
+      return false;
+    that->_curPos -= that->_delta;
+    if (that->_curPos < 0.0)
+      that->_curPos = 0.0;
+  }
+  _SCurveIterUpdateSeg(that);
   return true;
 }
 
@@ -1366,6 +2133,213 @@ VecFloat* SCurveIterGet(const SCurveIter* const that) {
   return SCurveGet(SCurveIterCurve(that), that->_curPos);  
 }
 
+// Get the current value of the attached SCurve at the current 
+// internal position of the SCurveIter 'that' and store it in the 
+// array 'res' allocated by the user with at least _dim floats
+// No memory allocation occurs
+#if BUILDMODE != 0
+static inline
+#endif 
+void SCurveIterGetVal(const SCurveIter* const that, float* const res) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (that->_iSeg < 0 || that->_iSeg >= SCurveGetNbSeg(that->_curve)) {
+    BCurveErr->_type = PBErrTypeInvalidData;
+    sprintf(BCurveErr->_msg, "'that' 's segment is stale (0<=%d<%d)", 
+      that->_iSeg, SCurveGetNbSeg(that->_curve));
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Evaluate the current segment at the current local parameter
+  const BCurve* seg = SCurveSeg(that->_curve, that->_iSeg);
+  if (seg->_usePowerBasis == true || 
+    _BCurveGetSpecialized(seg, that->_uloc, res, 1) == false)
+    BCurveGetBatch(seg, 1, &(that->_uloc), res, false);
+}
+
+// Update the segment of the SCurveIter 'that' at its current position
+#if BUILDMODE != 0
+static inline
+#endif 
+void _SCurveIterUpdateSeg(SCurveIter* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // If the current position has left the current segment, or the 
+  // segment doesn't exist anymore, look for the new one, else only 
+  // update the local parameter
+  int nbSeg = SCurveGetNbSeg(that->_curve);
+  if ((that->_curPos >= (float)(that->_iSeg + 1) && 
+    that->_iSeg + 1 < nbSeg) ||
+    (that->_curPos < (float)(that->_iSeg) && that->_iSeg > 0) ||
+    that->_iSeg >= nbSeg)
+    that->_iSeg = 
+      SCurveGetSegIndex(that->_curve, that->_curPos, &(that->_uloc));
+  else
+    that->_uloc = that->_curPos - (float)(that->_iSeg);
+}
+
+// -------------- SCurveBVH
+
+// ================ Functions implementation ====================
+
+// Return true if the bounding box 'bound' of dimension 'dim' 
+// satisfies the query of type 'type' (0: box, 1: ray, 2: point) with 
+// arguments 'a', 'b' and 'r' (cf _SCurveBVHQuery)
+#if BUILDMODE != 0
+static inline
+#endif 
+bool _SCurveBVHMatch(const float* const bound, const int dim, 
+  const int type, const float* const a, const float* const b, 
+  const float r) {
+  // Box 'a' 'b'
+  if (type == 0) {
+    for (int i = dim; i--;)
+      if (bound[i] > b[i] || bound[dim + i] < a[i])
+        return false;
+    return true;
+  // Ray 'a' + t * 'b', t in [0, 'r'], slab test
+  } else if (type == 1) {
+    float t0 = 0.0;
+    float t1 = r;
+    for (int i = dim; i--;) {
+      if (b[i] == 0.0) {
+        if (a[i] < bound[i] || a[i] > bound[dim + i])
+          return false;
+      } else {
+        float ta = (bound[i] - a[i]) / b[i];
+        float tb = (bound[dim + i] - a[i]) / b[i];
+        t0 = MAX(t0, MIN(ta, tb));
+        t1 = MIN(t1, MAX(ta, tb));
+        if (t0 > t1)
+          return false;
+      }
+    }
+    return true;
+  // Point 'a' with radius 'r'
+  } else {
+    return (_SCurveBVHGetDist2(bound, dim, a) <= r * r);
+  }
+}
+
+// Return the square of the distance from the point 'point' to the 
+// bounding box 'bound' of dimension 'dim'
+#if BUILDMODE != 0
+static inline
+#endif 
+float _SCurveBVHGetDist2(const float* const bound, const int dim, 
+  const float* const point) {
+  float dist = 0.0;
+  for (int i = dim; i--;) {
+    float d = 0.0;
+    if (point[i] < bound[i])
+      d = bound[i] - point[i];
+    else if (point[i] > bound[dim + i])
+      d = point[i] - bound[dim + i];
+    dist += d * d;
+  }
+  return dist;
+}
+
+// Calculate the value 'val', first derivative 'd1' and second 
+// derivative 'd2' (if they are not null) at 't' of the Bezier curve 
+// of order 'order' and dimension 'dim' with control points 'ctrl'
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetValDeriv(VecFloat* const* const ctrl, const int order,
+  const int dim, const float t, float* const val, float* const d1, 
+  float* const d2) {
+  // Calculate the Bernstein polynomials of order 'order', and of 
+  // order 'order' - 1 and 'order' - 2 for the derivatives, once for 
+  // all the dimensions
+  float w[order + 1];
+  float w1[order + 1];
+  float w2[order + 1];
+  w[0] = 1.0;
+  w1[0] = 0.0;
+  w2[0] = 0.0;
+  for (int sub = 1; sub <= order; ++sub) {
+    if (sub == order - 1)
+      memcpy(w2, w, sizeof(float) * sub);
+    else if (sub == order)
+      memcpy(w1, w, sizeof(float) * sub);
+    w[sub] = t * w[sub - 1];
+    for (int k = sub - 1; k > 0; --k)
+      w[k] = (1.0 - t) * w[k] + t * w[k - 1];
+    w[0] = (1.0 - t) * w[0];
+  }
+  // Loop on dimension
+  for (int i = dim; i--;) {
+    float v = 0.0;
+    for (int k = order + 1; k--;)
+      v += w[k] * ctrl[k]->_val[i];
+    val[i] = v;
+    if (d1 != NULL) {
+      float dv = 0.0;
+      for (int k = order; k--;)
+        dv += w1[k] * (ctrl[k + 1]->_val[i] - ctrl[k]->_val[i]);
+      d1[i] = (float)order * dv;
+    }
+    if (d2 != NULL) {
+      float ddv = 0.0;
+      for (int k = order - 1; k-- > 0;)
+        ddv += w2[k] * (ctrl[k + 2]->_val[i] - 
+          2.0 * ctrl[k + 1]->_val[i] + ctrl[k]->_val[i]);
+      d2[i] = (float)(order * (order - 1)) * ddv;
+    }
+  }
+}
+
+// -------------- SCurveFitter
+
+// ================ Functions implementation ====================
+
+// Get the SCurve made of the segments emitted by the SCurveFitter 
+// 'that' since the last call to SCurveFitterDrain or 
+// SCurveFitterFlush, NULL if there is none
+#if BUILDMODE != 0
+static inline
+#endif 
+const SCurve* SCurveFitterCurve(const SCurveFitter* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  return that->_curve;
+}
+
+// Get the number of points in the window of the SCurveFitter 'that'
+#if BUILDMODE != 0
+static inline
+#endif 
+int SCurveFitterGetNbPoint(const SCurveFitter* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  return that->_nbPoint;
+}
+
 // -------------- BBody
 
 // ================ Functions implementation ====================
@@ -1411,6 +2385,8 @@ void _BBodySetCtrl(BBody* const that, const VecShort* const iCtrl,
   if (index != -1)
     // Set the ctrl
     VecCopy(that->_ctrl[index], v);
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Get the number of control points of the BBody 'that'
@@ -1429,6 +2405,54 @@ int BBodyGetNbCtrl(const BBody* const that) {
   return powi(that->_order + 1, VecGet(&(that->_dim), 0));
 }
 
+// Contract the tensor 'in' of dimensions 'nbOuter' x 'nbCtrl' x 
+// 'nbInner' along its second dimension with the weights 'w' of 
+// 'nbSample' x 'nbCtrl' floats, and store the result in 'out' of 
+// dimensions 'nbOuter' x 'nbSample' x 'nbInner'
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BBodyContract(const float* const in, const long nbOuter, 
+  const int nbCtrl, const long nbInner, const float* const w, 
+  const int nbSample, float* const out) {
+  for (long iOuter = 0; iOuter < nbOuter; ++iOuter) {
+    const float* src = in + iOuter * nbCtrl * nbInner;
+    float* dst = out + iOuter * nbSample * nbInner;
+    for (int iSample = 0; iSample < nbSample; ++iSample) {
+      const float* wSample = w + iSample * nbCtrl;
+      float* val = dst + iSample * nbInner;
+      for (long i = nbInner; i--;)
+        val[i] = wSample[0] * src[i];
+      for (int k = 1; k < nbCtrl; ++k) {
+        const float* srcK = src + k * nbInner;
+        for (long i = nbInner; i--;)
+          val[i] += wSample[k] * srcK[i];
+      }
+    }
+  }
+}
+
+// Get the number of floats of the working memory needed by 
+// BBodyGetVal for the BBody 'that'
+#if BUILDMODE != 0
+static inline
+#endif 
+long BBodyGetNbScratch(const BBody* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // The weights of each input, followed by the control points 
+  // contracted along the last input
+  int nbCtrlInp = that->_order + 1;
+  int nbInputs = VecGet(&(that->_dim), 0);
+  return nbInputs * nbCtrlInp + 
+    powi(nbCtrlInp, nbInputs - 1) * VecGet(&(that->_dim), 1);
+}
+
 // Get the the 'iCtrl'-th control point of 'that'
 #if BUILDMODE != 0
 static inline
@@ -1549,6 +2573,8 @@ VecShort2D BBodyGetDim(const BBody* const that) {
 }
 
 // Return the center of the BBody (average of control points)
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
 #if BUILDMODE != 0
 static inline
 #endif 
@@ -1560,14 +2586,40 @@ VecFloat* BBodyGetCenter(const BBody* const that) {
     PBErrCatch(BCurveErr);
   }
 #endif
-  // Sum all the control points
-  VecFloat* center = VecFloatCreate(VecGet(BBodyDim(that), 1));
-  for (int iCtrl = BBodyGetNbCtrl(that); iCtrl--;)
-    VecOp(center, 1.0, that->_ctrl[iCtrl], 1.0);
-  // Get the average
-  VecScale(center, 1.0 / (float)(BBodyGetNbCtrl(that)));
-  // Return the result
-  return center;
+  // If the center is not in the cache
+  if (that->_center == NULL) {
+    // Sum all the control points
+    VecFloat* center = VecFloatCreate(VecGet(BBodyDim(that), 1));
+    for (int iCtrl = BBodyGetNbCtrl(that); iCtrl--;)
+      VecOp(center, 1.0, that->_ctrl[iCtrl], 1.0);
+    // Get the average
+    VecScale(center, 1.0 / (float)(BBodyGetNbCtrl(that)));
+    ((BBody*)that)->_center = center;
+  }
+  // Return a copy of the cached center
+  return VecClone(that->_center);
+}
+
+// Free the cached data of the BBody 'that'
+// Must be called each time the control points of the BBody are 
+// modified
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BBodyInvalidateCache(BBody* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Free the bounding boxes and the center
+  free(that->_bound);
+  that->_bound = NULL;
+  free(that->_tightBound);
+  that->_tightBound = NULL;
+  VecFree(&(that->_center));
 }
 
 // Translate the BBody by 'v'
@@ -1597,6 +2649,8 @@ void _BBodyTranslate(BBody* const that, const VecFloat* const v) {
   for (int iCtrl = BBodyGetNbCtrl(that); iCtrl--;)
     // Translate the control point
     VecOp(that->_ctrl[iCtrl], 1.0, v, 1.0);
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Scale the BBody by 'v' relatively to the origin
@@ -1630,6 +2684,8 @@ void _BBodyScaleOriginVector(BBody* const that,
     for (long dim = 0; dim < VecGetDim(ctrl); ++dim)
       VecSet(ctrl, dim, VecGet(ctrl, dim) * VecGet(v, dim));
   }
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Scale the BBody by 'c' relatively to the origin
@@ -1648,6 +2704,8 @@ void _BBodyScaleOriginScalar(BBody* const that, const float c) {
   for (int iCtrl = BBodyGetNbCtrl(that); iCtrl--;)
     // Scale the control point
     VecScale(that->_ctrl[iCtrl], c);
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Scale the BBody by 'v' relatively to its origin
@@ -1685,6 +2743,8 @@ void _BBodyScaleStartVector(BBody* const that, const VecFloat* const v) {
     // Translate back the control point
     VecOp(ctrl, 1.0, that->_ctrl[0], 1.0);
   }
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Scale the BBody by 'c' relatively to its origin
@@ -1710,6 +2770,8 @@ void _BBodyScaleStartScalar(BBody* const that, const float c) {
     // Translate back the control point
     VecOp(ctrl, 1.0, that->_ctrl[0], 1.0);
   }
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Scale the BBody by 'v' relatively to its center
@@ -1751,6 +2813,8 @@ void _BBodyScaleCenterVector(BBody* const that,
   }
   // Free memory
   VecFree(&center);
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Scale the BBody by 'c' relatively to its center
@@ -1779,6 +2843,8 @@ void _BBodyScaleCenterScalar(BBody* const that, const float c) {
   }
   // Free memory
   VecFree(&center);
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Rotate the BBody by 'theta' relatively to the origin
@@ -1813,6 +2879,8 @@ void BBodyRotAxisOrigin(BBody* const that,
     // Rotate the control point
     VecRotAxis((VecFloat3D*)ctrl, axis, theta);
   }
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Rotate the BBody by 'theta' relatively to the center
@@ -1854,6 +2922,8 @@ void BBodyRotAxisCenter(BBody* const that,
   }
   // Free memory
   VecFree(&center);
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Rotate the BBody by 'theta' relatively to the first control point
@@ -1893,6 +2963,8 @@ void BBodyRotAxisStart(BBody* const that, const VecFloat3D* const axis,
     // Translate back the control point
     VecOp(ctrl, 1.0, start, 1.0);
   }
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Rotate the BBody by 'theta' relatively to the origin
@@ -1921,6 +2993,8 @@ void BBodyRotXOrigin(BBody* const that, const float theta) {
     // Rotate the control point
     VecRotX((VecFloat3D*)ctrl, theta);
   }
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Rotate the BBody by 'theta' relatively to the center
@@ -1956,6 +3030,8 @@ void BBodyRotXCenter(BBody* const that, const float theta) {
   }
   // Free memory
   VecFree(&center);
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Rotate the BBody by 'theta' relatively to the first control point
@@ -1989,6 +3065,8 @@ void BBodyRotXStart(BBody* const that, const float theta) {
     // Translate back the control point
     VecOp(ctrl, 1.0, start, 1.0);
   }
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Rotate the BBody by 'theta' relatively to the origin
@@ -2017,6 +3095,8 @@ void BBodyRotYOrigin(BBody* const that, const float theta) {
     // Rotate the control point
     VecRotY((VecFloat3D*)ctrl, theta);
   }
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Rotate the BBody by 'theta' relatively to the center
@@ -2052,6 +3132,8 @@ void BBodyRotYCenter(BBody* const that, const float theta) {
   }
   // Free memory
   VecFree(&center);
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Rotate the BBody by 'theta' relatively to the first control point
@@ -2085,6 +3167,8 @@ void BBodyRotYStart(BBody* const that, const float theta) {
     // Translate back the control point
     VecOp(ctrl, 1.0, start, 1.0);
   }
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Rotate the BBody by 'theta' relatively to the origin
@@ -2113,6 +3197,8 @@ void BBodyRotZOrigin(BBody* const that, const float theta) {
     // Rotate the control point
     VecRotZ((VecFloat3D*)ctrl, theta);
   }
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Rotate the BBody by 'theta' relatively to the center
@@ -2148,6 +3234,8 @@ void BBodyRotZCenter(BBody* const that, const float theta) {
   }
   // Free memory
   VecFree(&center);
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
 }
 
 // Rotate the BBody by 'theta' relatively to the first control point
@@ -2181,5 +3269,114 @@ void BBodyRotZStart(BBody* const that, const float theta) {
     // Translate back the control point
     VecOp(ctrl, 1.0, start, 1.0);
   }
+  // Invalidate the cached data
+  _BBodyInvalidateCache(that);
+}
+
+// Get the value of the BBody 'that' at parameter 'u' with the 
+// evaluation specialized for orders 1 to 3 and input dimensions 2 
+// and 3, and add it to 'res' which must be a null vector of dimension 
+// equal to the output dimension
+// Return true if there is such a specialization, false else (and 
+// 'res' is left unchanged)
+#if BUILDMODE != 0
+static inline
+#endif 
+bool _BBodyGetSpecialized(const BBody* const that, 
+  const VecFloat* const u, VecFloat* const res) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (u == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'u' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (VecGetDim(u) != VecGet(&(that->_dim), 0)) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "Dimension of 'u' is invalid (%ld=%d)", 
+      VecGetDim(u), VecGet(&(that->_dim), 0));
+    PBErrCatch(BCurveErr);
+  }
+  if (VecGetDim(res) != VecGet(&(that->_dim), 1)) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "Dimension of 'res' is invalid (%ld=%d)", 
+      VecGetDim(res), VecGet(&(that->_dim), 1));
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Declare a variable to memorize the number of inputs
+  int nbInputs = VecGet(&(that->_dim), 0);
+  // If there is no specialization for this order and input dimension
+  if (that->_order < 1 || that->_order > 3 || 
+    nbInputs < 2 || nbInputs > 3)
+    return false;
+  // Get the weights of the control points per input
+  float w[3][4];
+  for (int iInp = nbInputs; iInp--;) {
+    if (that->_order == 1)
+      _BCurveGetWeightOrder1(VecGet(u, iInp), w[iInp]);
+    else if (that->_order == 2)
+      _BCurveGetWeightOrder2(VecGet(u, iInp), w[iInp]);
+    else
+      _BCurveGetWeightOrder3(VecGet(u, iInp), w[iInp]);
+  }
+  // Declare variables to memorize the number of control points per 
+  // input and the output dimension
+  int nbCtrlInp = that->_order + 1;
+  int nbDimOut = VecGet(&(that->_dim), 1);
+  // Sum the control points multiplied by their weight (product of 
+  // the weight per input), in the same order as the generic 
+  // evaluation
+  int iCtrl = BBodyGetNbCtrl(that);
+  if (nbInputs == 2) {
+    for (int i0 = nbCtrlInp; i0--;) {
+      for (int i1 = nbCtrlInp; i1--;) {
+        float weight = w[1][i1] * w[0][i0];
+        const float* ctrl = that->_ctrl[--iCtrl]->_val;
+        for (int iDim = nbDimOut; iDim--;)
+          res->_val[iDim] += weight * ctrl[iDim];
+      }
+    }
+  } else {
+    for (int i0 = nbCtrlInp; i0--;) {
+      for (int i1 = nbCtrlInp; i1--;) {
+        for (int i2 = nbCtrlInp; i2--;) {
+          float weight = w[2][i2] * w[1][i1] * w[0][i0];
+          const float* ctrl = that->_ctrl[--iCtrl]->_val;
+          for (int iDim = nbDimOut; iDim--;)
+            res->_val[iDim] += weight * ctrl[iDim];
+        }
+      }
+    }
+  }
+  // Return the success flag
+  return true;
 }
 
+// -------------- BBodyFitter
+
+// ================ Functions implementation ====================
+
+// Get the number of points added to the BBodyFitter 'that'
+#if BUILDMODE != 0
+static inline
+#endif 
+long BBodyFitterGetNbPoint(const BBodyFitter* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  return that->_nbPoint;
+}
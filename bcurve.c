@@ -30,6 +30,12 @@ BCurve* BCurveCreate(const int order, const int dim) {
   // Set the values
   *((int*)&(that->_dim)) = dim;
   *((int*)&(that->_order)) = order;
+  that->_packed = false;
+  that->_usePowerBasis = false;
+  that->_powerBasis = NULL;
+  that->_bound = NULL;
+  that->_tightBound = NULL;
+  that->_center = NULL;
   // Allocate memory for the array of control points
   that->_ctrl = PBErrMalloc(BCurveErr, sizeof(VecFloat*) * (order + 1));
   // For each control point
@@ -40,6 +46,79 @@ BCurve* BCurveCreate(const int order, const int dim) {
   return that;
 }
 
+// Create a new BCurve of order 'order' and dimension 'dim' whose 
+// array of control points and control points are allocated in one 
+// single block of memory together with the BCurve
+// The control points are stored one after the other at a constant 
+// stride, and are still accessible as VecFloat 
+BCurve* BCurveCreatePacked(const int order, const int dim) {
+#if BUILDMODE == 0
+  if (order < 0) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "Invalid order (%d>=0)", order);
+    PBErrCatch(BCurveErr);
+  }
+  if (dim < 1) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "Invalid dimension (%d>=1)", dim);
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Get the size of one control point, rounded up to keep the 
+  // alignment of the next one
+  size_t sizeCtrl = sizeof(VecFloat) + sizeof(float) * dim;
+  sizeCtrl = (sizeCtrl + _Alignof(VecFloat) - 1) / 
+    _Alignof(VecFloat) * _Alignof(VecFloat);
+  // Allocate memory for the BCurve, the array of control points and 
+  // the control points
+  size_t size = sizeof(BCurve) + sizeof(VecFloat*) * (order + 1) +
+    sizeCtrl * (order + 1);
+  BCurve* that = PBErrMalloc(BCurveErr, size);
+  memset(that, 0, size);
+  // Set the values
+  *((int*)&(that->_dim)) = dim;
+  *((int*)&(that->_order)) = order;
+  that->_packed = true;
+  that->_usePowerBasis = false;
+  that->_powerBasis = NULL;
+  that->_bound = NULL;
+  that->_tightBound = NULL;
+  that->_center = NULL;
+  // Set the array of control points right after the BCurve
+  that->_ctrl = (VecFloat**)(that + 1);
+  // Set the control points right after the array of control points
+  char* block = (char*)(that->_ctrl + order + 1);
+  // For each control point
+  for (int iCtrl = order + 1; iCtrl--;) {
+    that->_ctrl[iCtrl] = (VecFloat*)(block + sizeCtrl * iCtrl);
+    *((long*)&(that->_ctrl[iCtrl]->_dim)) = dim;
+  }
+  // Return the new BCurve
+  return that;
+}
+
+// Return true if the control points of the BCurve 'that' are stored 
+// one after the other at a constant stride, false else
+bool _BCurveIsStrided(const BCurve* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // A BCurve of order 0 is strided by definition
+  if (that->_order == 0)
+    return true;
+  // Check the distance in memory between consecutive control points
+  long stride = (char*)(that->_ctrl[1]) - (char*)(that->_ctrl[0]);
+  for (int iCtrl = 2; iCtrl <= that->_order; ++iCtrl)
+    if ((char*)(that->_ctrl[iCtrl]) - (char*)(that->_ctrl[iCtrl - 1]) != 
+      stride)
+      return false;
+  return (stride >= (long)(sizeof(VecFloat) + sizeof(float) * that->_dim));
+}
+
 // Clone the BCurve
 BCurve* BCurveClone(const BCurve* const that) {
 #if BUILDMODE == 0
@@ -48,12 +127,35 @@ BCurve* BCurveClone(const BCurve* const that) {
     sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
+  if (that->_packed == true && _BCurveIsStrided(that) == false) {
+    BCurveErr->_type = PBErrTypeInvalidData;
+    sprintf(BCurveErr->_msg, "'that' is packed but not strided");
+    PBErrCatch(BCurveErr);
+  }
 #endif
+  // If the control points of the BCurve are packed
+  if (that->_packed == true) {
+    // Create a packed clone
+    BCurve* clone = BCurveCreatePacked(that->_order, that->_dim);
+    // For each control point
+    for (int iCtrl = clone->_order + 1; iCtrl--;)
+      // Copy the control point
+      VecCopy(clone->_ctrl[iCtrl], that->_ctrl[iCtrl]);
+    clone->_usePowerBasis = that->_usePowerBasis;
+    // Return the clone
+    return clone;
+  }
   // Allocate memory for the clone
   BCurve* clone = PBErrMalloc(BCurveErr, sizeof(BCurve));
   // Clone the properties
   *((int*)&(clone->_dim)) = that->_dim;
   *((int*)&(clone->_order)) = that->_order;
+  clone->_packed = false;
+  clone->_usePowerBasis = that->_usePowerBasis;
+  clone->_powerBasis = NULL;
+  clone->_bound = NULL;
+  clone->_tightBound = NULL;
+  clone->_center = NULL;
   // Allocate memory for the array of control points
   clone->_ctrl = PBErrMalloc(BCurveErr, sizeof(VecFloat*) * 
     (clone->_order + 1));
@@ -110,6 +212,10 @@ bool BCurveDecodeAsJSON(BCurve** that, const JSONNode* const json) {
     PBErrCatch(PBMathErr);
   }
 #endif
+  // Memorize the storage mode and evaluation mode of 'that' if it is 
+  // already allocated
+  bool packed = (*that != NULL && (*that)->_packed);
+  bool usePowerBasis = (*that != NULL && (*that)->_usePowerBasis);
   // If 'that' is already allocated
   if (*that != NULL)
     // Free memory
@@ -129,8 +235,12 @@ bool BCurveDecodeAsJSON(BCurve** that, const JSONNode* const json) {
   // If data are invalid
   if (order < 0 || dim < 1)
     return false;
-  // Allocate memory
-  *that = BCurveCreate(order, dim);
+  // Allocate memory, keeping the storage mode
+  if (packed == true)
+    *that = BCurveCreatePacked(order, dim);
+  else
+    *that = BCurveCreate(order, dim);
+  BCurveSetUsePowerBasis(*that, usePowerBasis);
   // Decode the control points
   prop = JSONProperty(json, "_ctrl");
   if (prop == NULL) {
@@ -140,11 +250,18 @@ bool BCurveDecodeAsJSON(BCurve** that, const JSONNode* const json) {
     return false;
   }
   for (int iCtrl = 0; iCtrl < order + 1; ++iCtrl) {
+    VecFloat* loadCtrl = NULL;
     JSONNode* ctrl = JSONValue(prop, iCtrl);
-    if (!VecDecodeAsJSON((*that)->_ctrl + iCtrl, ctrl) ||
-      VecGetDim((*that)->_ctrl[iCtrl]) != BCurveGetDim(*that)) {
+    if (!VecDecodeAsJSON(&loadCtrl, ctrl) ||
+      VecGetDim(loadCtrl) != BCurveGetDim(*that)) {
+      VecFree(&loadCtrl);
       return false;
     }
+    // Copy the loaded control point into the control points of the 
+    // BCurve, which may be packed
+    VecCopy((*that)->_ctrl[iCtrl], loadCtrl);
+    // Free memory used by the loaded control
+    VecFree(&loadCtrl);
   }
   // Return the success code
   return true;
@@ -217,14 +334,26 @@ void BCurveFree(BCurve** that) {
   // Check argument
   if (that == NULL || *that == NULL)
     return;
-  // If there are control points
-  if ((*that)->_ctrl != NULL)
-    // For each control point
-    for (int iCtrl = (*that)->_order + 1; iCtrl--;)
-      // Free the control point
-      VecFree((*that)->_ctrl + iCtrl);
-  // Free the array of control points
-  free((*that)->_ctrl);
+#if BUILDMODE == 0
+  if ((*that)->_packed == true && _BCurveIsStrided(*that) == false) {
+    BCurveErr->_type = PBErrTypeInvalidData;
+    sprintf(BCurveErr->_msg, "'that' is packed but not strided");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // If the control points are not packed with the BCurve
+  if ((*that)->_packed == false) {
+    // If there are control points
+    if ((*that)->_ctrl != NULL)
+      // For each control point
+      for (int iCtrl = (*that)->_order + 1; iCtrl--;)
+        // Free the control point
+        VecFree((*that)->_ctrl + iCtrl);
+    // Free the array of control points
+    free((*that)->_ctrl);
+  }
+  // Free the cached data
+  _BCurveInvalidateCache(*that);
   // Free memory
   free(*that);
   *that = NULL;
@@ -266,199 +395,226 @@ VecFloat* BCurveGet(const BCurve* const that, const float u) {
 #endif
   // Allocate memory for the result
   VecFloat* v = VecFloatCreate(that->_dim);
-  // Declare a variable for calcul
-  VecFloat* val = VecFloatCreate(that->_order + 1);
-  // Loop on dimension
-  for (int dim = that->_dim; dim--;) {
-    // Initialise the temporary variable with the value in current
-    // dimension of the control points
-    for (int iCtrl = 0; iCtrl < that->_order + 1; ++iCtrl)
-      VecSet(val, iCtrl, VecGet(that->_ctrl[iCtrl], dim));
+  // Evaluate the curve directly into the result, with the power basis
+  // if it is used, else with the unrolled evaluation if there is one 
+  // for this order and dimension
+  if (that->_usePowerBasis == true || 
+    _BCurveGetSpecialized(that, u, v->_val, 1) == false)
+    BCurveGetBatch(that, 1, &u, v->_val, false);
+  // Return the result
+  return v;
+}
+
+// Type used to evaluate BCURVE_NBLANE parameters in parallel
+typedef float BCurveLanes 
+  __attribute__((vector_size(sizeof(float) * BCURVE_NBLANE)));
+
+// Vectorized kernel of the De Casteljau algorithm in one dimension 
+// for a BCurve of order 'order' whose control points' values in that 
+// dimension are 'ctrl'
+// Evaluate 'nbBlock' blocks of BCURVE_NBLANE parameters 'u' in 
+// parallel and store the results in 'res' with a stride of 'stride'
+BCURVE_SIMDDISPATCH
+void _BCurveGetBatchKernel(const float* const ctrl, const int order, 
+  const long nbBlock, const float* const u, float* const res, 
+  const long stride) {
+#if BUILDMODE == 0
+  if (ctrl == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'ctrl' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (u == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'u' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Declare a variable to memorize the temporary values of the 
+  // De Casteljau algorithm, one lane per parameter
+  BCurveLanes val[order + 1];
+  // Loop on blocks of parameters
+  for (long iBlock = 0; iBlock < nbBlock; ++iBlock) {
+    // Load the parameters of the block
+    BCurveLanes t;
+    memcpy(&t, u + iBlock * BCURVE_NBLANE, sizeof(BCurveLanes));
+    BCurveLanes s = 1.0f - t;
+    // Initialise the temporary variable with the value of the 
+    // control points
+    for (int iCtrl = order + 1; iCtrl--;)
+      val[iCtrl] = ctrl[iCtrl] + (BCurveLanes){0};
     // Loop on order
-    int subOrder = that->_order;
-    while (subOrder != 0) {
+    for (int subOrder = order; subOrder != 0; --subOrder) {
       // Loop on sub order
-      for (int order = 0; order < subOrder; ++order)
-        VecSet(val, order, 
-          (1.0 - u) * VecGet(val, order) + u * VecGet(val, order + 1));
-      --subOrder;
+      for (int iCtrl = 0; iCtrl < subOrder; ++iCtrl)
+        val[iCtrl] = s * val[iCtrl] + t * val[iCtrl + 1];
     }
-    // Set the value for the current dim
-    VecSet(v, dim, VecGet(val, 0));
+    // Store the results
+    float* r = res + iBlock * BCURVE_NBLANE * stride;
+    for (int iLane = 0; iLane < BCURVE_NBLANE; ++iLane)
+      r[iLane * stride] = val[0][iLane];
   }
-  // Free memory
-  VecFree(&val);
-  // Return the result
-  return v;
 }
 
-// Create a BCurve which pass through the points given in the GSet 'set'
-// The GSet must contains VecFloat of same dimensions
-// The BCurve pass through the points in the order they are given
-// in the GSet. The points don't need to be uniformly distributed
-// The created BCurve is of same dimension as the VecFloat and of order 
-// equal to the number of VecFloat in 'set' minus one
-// Return NULL if it couldn't create the BCurve
-BCurve* BCurveFromCloudPoint(const GSetVecFloat* const set) {
+// Get the values of the BCurve at the 'nbU' paramaters 'u' and 
+// store them in the array 'res' allocated by the user with at least 
+// 'nbU' * _dim floats
+// If 'soa' is false the values are stored point by point 
+// (res[iU * _dim + iDim]), else they are stored dimension by dimension
+// (res[iDim * nbU + iU])
+// u can extend beyond [0.0, 1.0]
+// No memory allocation occurs
+void BCurveGetBatch(const BCurve* const that, const long nbU, 
+  const float* const u, float* const res, const bool soa) {
 #if BUILDMODE == 0
-  if (set == NULL) {
+  if (that == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
-    sprintf(BCurveErr->_msg, "'set' is null");
+    sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
-  if (GSetNbElem(set) < 1) {
+  if (u == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'u' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (nbU < 0) {
     BCurveErr->_type = PBErrTypeInvalidArg;
-    sprintf(BCurveErr->_msg, "'set' is empty");
+    sprintf(BCurveErr->_msg, "'nbU' is invalid (%ld>=0)", nbU);
     PBErrCatch(BCurveErr);
   }
 #endif
-  // Declare a variable to memorize the result
-  int order = GSetNbElem(set) - 1;
-  long dim = VecGetDim(GSetHead(set));
-  BCurve* curve = BCurveCreate(order, dim);
-  // Set the first control point to the first point in the point cloud
-  BCurveSetCtrl(curve, 0, GSetHead(set));
-  // If the order is greater than 0
-  if (order > 0) {
-    // Set the last control point to the last point in the point cloud
-    BCurveSetCtrl(curve, order, GSetTail(set));
-    // If the order is greater than 1
-    if (order > 1) {
-      // Calculate the t values for intermediate control points
-      // They are equal to the relative distance on the polyline
-      // linking the point in the point cloud
-      // Declare a variable to memorize the dimension of the matrix
-      // in the linear system to solve
-      VecShort2D dimMat = VecShortCreateStatic2D();
-      // Declare a variable to memorize the t values
-      VecFloat* t = VecFloatCreate(GSetNbElem(set));
-      // Set the dimensions of the matrix of the linear system
-      VecSet(&dimMat, 0, order - 1);
-      VecSet(&dimMat, 1, order - 1);
-      // For each point 
-      GSetIterForward iter = GSetIterForwardCreateStatic(set);
-      (void)GSetIterStep(&iter);
-      int iPoint = 1;
-      do {
-        // Get the distance from the previous point
-        VecFloat* curPoint = GSetIterGet(&iter);
-        VecFloat* prevPoint = 
-          GSetElemData(GSetElemPrev(GSetIterGetElem(&iter)));
-        float d = VecDist(prevPoint, curPoint);
-        VecSet(t, iPoint, d + VecGet(t, iPoint - 1));
-        ++iPoint;
-      } while(GSetIterStep(&iter));
-      // Normalize t
-      for (iPoint = 1; iPoint <= order; ++iPoint)
-        VecSet(t, iPoint, VecGet(t, iPoint) / VecGet(t, order));
-      // For each dimension
-      for (long iDim = dim; iDim--;) {
-        // Declare a variable to memorize the matrix and vector 
-        // of the linear system
-        MatFloat* m = MatFloatCreate(&dimMat);
-        VecFloat* v = VecFloatCreate(order - 1);
-        // Set the values of the linear system
-        // For each line (equivalent to each intermediate point 
-        // in point cloud)
-        for (VecSet(&dimMat, 1, 0); 
-          VecGet(&dimMat, 1) < order - 1;
-          VecSetAdd(&dimMat, 1, 1)) {
-          // Get the weight of the control point at the value 
-          // of t for this point
-          VecFloat* weight = 
-            BCurveGetWeightCtrlPt(curve, VecGet(t, 
-            VecGet(&dimMat, 1) + 1));
-          // For each intermediate control point
-          for (VecSet(&dimMat, 0, 0); 
-            VecGet(&dimMat, 0) < order - 1;
-            VecSetAdd(&dimMat, 0, 1))
-            // Set the matrix value with the corresponding
-            // weight
-            MatSet(m, &dimMat, VecGet(weight, 
-              VecGet(&dimMat, 0) + 1));
-          // Set the vector value with the corresponding point
-          // coordinate
-          float x = VecGet((VecFloat*)(GSetGet(set, 
-            VecGet(&dimMat, 1) + 1)), iDim);
-          x -= VecGet(weight, 0) * VecGet(GSetHead(set), iDim);
-          x -= VecGet(weight, order) * 
-            VecGet(GSetTail(set), iDim);
-          VecSet(v, VecGet(&dimMat, 1), x);
-          // Free memory
-          VecFree(&weight);
-        }
-        // Declare a variable to memorize the linear system
-        SysLinEq* sys = SysLinEqCreate(m, v);
-        // Solve the system
-        VecFloat* solSys = SysLinEqSolve(sys);
-        // If we could solve the linear system
-        if (solSys != NULL) {
-          // Memorize the values of control points for the 
-          // current dimension
-          for (int iCtrl = 1; iCtrl < order; ++iCtrl)
-            VecSet(curve->_ctrl[iCtrl], iDim, 
-              VecGet(solSys, iCtrl - 1));
-          // Free memory
-          VecFree(&solSys);
-        } else {
-          // Free memory
-          SysLinEqFree(&sys);
-          VecFree(&v);
-          MatFree(&m);
-          VecFree(&t);
-          BCurveFree(&curve);
-          // Return NULL
-          return NULL;
-        }
-        // Free memory
-        SysLinEqFree(&sys);
-        VecFree(&v);
-        MatFree(&m);
+  // Declare variables on the stack to memorize the control points 
+  // value in the current dimension and the temporary values of 
+  // the De Casteljau algorithm
+  float ctrl[that->_order + 1];
+  float val[that->_order + 1];
+  // Declare variables to memorize the strides in the result
+  long strideU = (soa ? 1 : that->_dim);
+  long strideDim = (soa ? nbU : 1);
+  // If the BCurve is evaluated with its coefficients in power basis
+  if (that->_usePowerBasis == true) {
+    // Calculate the coefficients if they are not in cache
+    if (that->_powerBasis == NULL)
+      _BCurveUpdatePowerBasis(that);
+    // Loop on dimension
+    for (int dim = that->_dim; dim--;) {
+      const float* coeff = that->_powerBasis + dim * (that->_order + 1);
+      // Loop on parameters
+      for (long iU = nbU; iU--;) {
+        // Evaluate the polynomial with the Horner scheme
+        float val = coeff[that->_order];
+        for (int iCoeff = that->_order; iCoeff--;)
+          val = val * u[iU] + coeff[iCoeff];
+        // Set the value for the current dim
+        res[iU * strideU + dim * strideDim] = val;
       }
-      // Free memory
-      VecFree(&t);
+    }
+    // Nothing else to do
+    return;
+  }
+  // Declare a variable to memorize the number of parameters evaluated
+  // by the vectorized kernel
+  long nbBlock = nbU / BCURVE_NBLANE;
+  // If there is an unrolled evaluation for this order and dimension
+  if (that->_order >= 1 && that->_order <= 3 && 
+    (that->_dim == 2 || that->_dim == 3)) {
+    // Evaluate the parameters by blocks with the vectorized kernel
+    if (nbBlock > 0) {
+      for (int dim = that->_dim; dim--;) {
+        for (int iCtrl = that->_order + 1; iCtrl--;)
+          ctrl[iCtrl] = VecGet(that->_ctrl[iCtrl], dim);
+        _BCurveGetBatchKernel(ctrl, that->_order, nbBlock, u, 
+          res + dim * strideDim, strideU);
+      }
+    }
+    // Evaluate the remaining parameters with the unrolled evaluation
+    for (long iU = nbU; iU-- > nbBlock * BCURVE_NBLANE;)
+      _BCurveGetSpecialized(that, u[iU], res + iU * strideU, strideDim);
+    // Nothing else to do
+    return;
+  }
+  // Loop on dimension
+  for (int dim = that->_dim; dim--;) {
+    // Get the values of the control points in the current dimension
+    for (int iCtrl = that->_order + 1; iCtrl--;)
+      ctrl[iCtrl] = VecGet(that->_ctrl[iCtrl], dim);
+    // Evaluate the parameters by blocks with the vectorized kernel
+    if (nbBlock > 0)
+      _BCurveGetBatchKernel(ctrl, that->_order, nbBlock, u, 
+        res + dim * strideDim, strideU);
+    // Loop on remaining parameters
+    for (long iU = nbU; iU-- > nbBlock * BCURVE_NBLANE;) {
+      // Initialise the temporary variable with the value in current
+      // dimension of the control points
+      memcpy(val, ctrl, sizeof(float) * (that->_order + 1));
+      // Loop on order
+      for (int subOrder = that->_order; subOrder != 0; --subOrder) {
+        // Loop on sub order
+        for (int order = 0; order < subOrder; ++order)
+          val[order] = 
+            (1.0 - u[iU]) * val[order] + u[iU] * val[order + 1];
+      }
+      // Set the value for the current dim
+      res[iU * strideU + dim * strideDim] = val[0];
     }
   }
-  // Return the result
-  return curve;
 }
 
-// Get a VecFloat of dimension equal to the number of control points
-// Values of the VecFloat are the weight of each control point in the 
-// BCurve given the curve's order and the value of 't' (in [0.0,1.0])
-VecFloat* BCurveGetWeightCtrlPt(const BCurve* const that, 
-  const float t) {
+// Get the derivative of the BCurve 'that' at parameter 'u' and store
+// it in the array 'res' allocated by the user with at least _dim floats
+// u can extend beyond [0.0, 1.0]
+// No memory allocation occurs
+void BCurveGetDerivative(const BCurve* const that, const float u, 
+  float* const res) {
 #if BUILDMODE == 0
   if (that == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
     sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
 #endif
-  // Declare a variable to memorize the result
-  VecFloat* res = VecFloatCreate(that->_order + 1);
-  // Initilize the two first weights
-  VecSet(res, 0, 1.0 - t);
-  VecSet(res, 1, t);
-  // For each higher order
-  for (int order = 1; order < that->_order; ++order) {
-    // For each control point at this order, starting by the last one
-    // to avoid using a temporary buffer
-    for (int iCtrl = order + 2; iCtrl-- && iCtrl != 0;)
-      // Calculate the weight of this control point
-      VecSet(res, iCtrl, 
-        (1.0 - t) * VecGet(res, iCtrl) + t * VecGet(res, iCtrl - 1));
-    // Calculate the weight of the first control point
-    VecSet(res, 0, (1.0 - t) * VecGet(res, 0));
+  // If the order is 0 the derivative is null
+  if (that->_order == 0) {
+    for (int dim = that->_dim; dim--;)
+      res[dim] = 0.0;
+    return;
+  }
+  // The derivative is the BCurve of order (_order - 1) whose control
+  // points are _order * (ctrl[i + 1] - ctrl[i])
+  float val[that->_order];
+  // Loop on dimension
+  for (int dim = that->_dim; dim--;) {
+    for (int iCtrl = that->_order; iCtrl--;)
+      val[iCtrl] = (float)(that->_order) * 
+        (VecGet(that->_ctrl[iCtrl + 1], dim) - 
+        VecGet(that->_ctrl[iCtrl], dim));
+    // Apply the De Casteljau algorithm
+    for (int subOrder = that->_order - 1; subOrder > 0; --subOrder)
+      for (int order = 0; order < subOrder; ++order)
+        val[order] = (1.0 - u) * val[order] + u * val[order + 1];
+    // Set the value for the current dim
+    res[dim] = val[0];
   }
-  // Return the result
-  return res;
 }
 
-// Get the bounding box of the BCurve.
-// Return a Facoid whose axis are aligned on the standard coordinate 
-// system.
-Facoid* BCurveGetBoundingBox(const BCurve* const that) {
+// Calculate the coefficients in power basis of the BCurve 'that' 
+// and cache them
+void _BCurveUpdatePowerBasis(const BCurve* const that) {
 #if BUILDMODE == 0
   if (that == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
@@ -466,143 +622,1071 @@ Facoid* BCurveGetBoundingBox(const BCurve* const that) {
     PBErrCatch(BCurveErr);
   }
 #endif
-  // Declare a variable to memorize the result
-  Facoid* res = FacoidCreate(BCurveGetDim(that));
-  // Create 2 vectors to memorize min and max coordinates in each 
-  // dimensions
-  VecFloat* min = VecClone(BCurveCtrl(that, 0));
-  VecFloat* max = VecClone(BCurveCtrl(that, 0));
-  // For each dimension
-  for (int iDim = that->_dim; iDim--;) {
-    // For each control point except the first one
-    for (int iCtrl = that->_order + 1; iCtrl-- && iCtrl != 0;) {
-      // Update the bounding box
-      if (BCurveCtrlGet(that, iCtrl, iDim) < VecGet(min, iDim))
-        VecSet(min, iDim, BCurveCtrlGet(that, iCtrl, iDim));
-      if (BCurveCtrlGet(that, iCtrl, iDim) > VecGet(max, iDim))
-        VecSet(max, iDim, BCurveCtrlGet(that, iCtrl, iDim));
-    }
-  }
-  // Update the result Facoid
-  ShapoidSetPos(res, min);
-  for (int iDim = that->_dim; iDim--;) {
-    float d = VecGet(max, iDim) - VecGet(min, iDim);
-    if (d < PBMATH_EPSILON)
-      d = 2.0 * PBMATH_EPSILON;
-    ShapoidAxisSet(res, iDim, iDim, d);
-  }
-  // Free memory
-  VecFree(&min);
-  VecFree(&max);
-  // Return the result
-  return res;
+  // The cache is not part of the curve's value, cast away the const
+  BCurve* curve = (BCurve*)that;
+  int nbCoeff = (that->_order + 1) * that->_dim;
+  // Allocate memory for the coefficients if necessary
+  if (curve->_powerBasis == NULL)
+    curve->_powerBasis = 
+      PBErrMalloc(BCurveErr, sizeof(float) * nbCoeff);
+  // Calculate the coefficients
+  double coeff[nbCoeff];
+  _BCurveGetPowerBasis(that, coeff);
+  for (int iCoeff = nbCoeff; iCoeff--;)
+    curve->_powerBasis[iCoeff] = coeff[iCoeff];
 }
 
-// -------------- SCurve
-
-// ================ Functions implementation ====================
+// Calculate the coefficients in power basis of the BCurve 'that' 
+// and store them in 'coeff' allocated by the user with at least 
+// (_order + 1) * _dim doubles, (_order + 1) values per dimension, from 
+// the constant to the highest degree
+void _BCurveGetPowerBasis(const BCurve* const that, 
+  double* const coeff) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (coeff == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'coeff' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  int nbCoeff = that->_order + 1;
+  // The coefficient of degree k is 
+  // C(order, k) * sum_{i=0..k} (-1)^(k-i) * C(k, i) * ctrl_i
+  // Declare a variable to memorize C(order, k)
+  double binomOrder = 1.0;
+  // Loop on degrees
+  for (int k = 0; k < nbCoeff; ++k) {
+    // Loop on dimension
+    for (int dim = that->_dim; dim--;) {
+      // Calculate the sum, in double to limit the loss of precision
+      double sum = 0.0;
+      double binomK = 1.0;
+      for (int i = 0; i <= k; ++i) {
+        double term = binomK * VecGet(that->_ctrl[i], dim);
+        sum += ((k - i) % 2 == 0 ? term : -term);
+        binomK = binomK * (double)(k - i) / (double)(i + 1);
+      }
+      coeff[dim * nbCoeff + k] = binomOrder * sum;
+    }
+    // Update C(order, k) for the next degree
+    binomOrder = 
+      binomOrder * (double)(that->_order - k) / (double)(k + 1);
+  }
+}
 
-// Create a new SCurve of dimension 'dim', order 'order' and 
-// 'nbSeg' segments
-SCurve* SCurveCreate(const int order, const int dim, const int nbSeg) {
+// Get the values of the BCurve 'that' at the 'nbPoint' parameters 
+// u0 + i * step, i in [0, nbPoint - 1], and store them point by 
+// point in the array 'res' allocated by the user with at least 
+// 'nbPoint' * _dim floats
+// The values are calculated by forward differencing, the differences 
+// being calculated again exactly every BCURVE_FDANCHOR points and for 
+// the last point to bound the drift
+// No memory allocation occurs
+void BCurveTessellateStep(const BCurve* const that, const float u0, 
+  const float step, const long nbPoint, float* const res) {
 #if BUILDMODE == 0
-  if (order < 0) {
-    BCurveErr->_type = PBErrTypeInvalidArg;
-    sprintf(BCurveErr->_msg, "Invalid order (%d>=0)", order);
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
-  if (dim < 1) {
-    BCurveErr->_type = PBErrTypeInvalidArg;
-    sprintf(BCurveErr->_msg, "Invalid dimension (%d>=1)", dim);
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
     PBErrCatch(BCurveErr);
   }
-  if (nbSeg < 1) {
+  if (nbPoint < 0) {
     BCurveErr->_type = PBErrTypeInvalidArg;
-    sprintf(BCurveErr->_msg, "Invalid number of segment (%d>=1)", nbSeg);
+    sprintf(BCurveErr->_msg, "'nbPoint' is invalid (%ld>=0)", nbPoint);
     PBErrCatch(BCurveErr);
   }
 #endif
-  // Allocate memory
-  SCurve* that = PBErrMalloc(BCurveErr, sizeof(SCurve));
-  // Set the values
-  int* d = (int*)&(that->_dim);
-  *d = dim;
-  int* o = (int*)&(that->_order);
-  *o = order;
-  that->_nbSeg = nbSeg;
-  // Create the GSet
-  that->_ctrl = GSetVecFloatCreateStatic();
-  that->_seg = GSetBCurveCreateStatic();
-  // For each segment
-  for (int iSeg = nbSeg; iSeg--;) {
-    // Create a segment
-    BCurve* seg = BCurveCreate(order, dim);
-    // If it's not the first added segment
-    if (iSeg != nbSeg - 1) {
-      // Replace the last control points by the current first
-      VecFree(seg->_ctrl + order);
-      seg->_ctrl[order] = GSetHead(&(that->_ctrl));
-      // Add the control points
-      for (int iCtrl = order; iCtrl--;)
-        GSetPush(&(that->_ctrl), (VecFloat*)BCurveCtrl(seg, iCtrl));
-    // Else, it's the first segment
-    } else {
-      // Add the control points
-      for (int iCtrl = order + 1; iCtrl--;)
-        GSetPush(&(that->_ctrl), (VecFloat*)BCurveCtrl(seg, iCtrl));
+  // Declare variables to memorize the number of coefficients per 
+  // dimension, the coefficients in power basis and the forward 
+  // differences (in double to limit the drift)
+  int nbCoeff = that->_order + 1;
+  double coeff[nbCoeff * that->_dim];
+  double diff[nbCoeff * that->_dim];
+  // Get the coefficients in power basis
+  _BCurveGetPowerBasis(that, coeff);
+  // Loop on points
+  for (long iPoint = 0; iPoint < nbPoint; ++iPoint) {
+    // If the differences need to be (re)anchored
+    if (iPoint % BCURVE_FDANCHOR == 0 || iPoint == nbPoint - 1) {
+      // Loop on dimension
+      for (int dim = that->_dim; dim--;) {
+        const double* c = coeff + dim * nbCoeff;
+        double* d = diff + dim * nbCoeff;
+        // Evaluate the polynomial at the current parameter and the 
+        // _order following ones with the Horner scheme
+        for (int j = nbCoeff; j--;) {
+          double u = (double)u0 + (double)step * (double)(iPoint + j);
+          d[j] = c[that->_order];
+          for (int iCoeff = that->_order; iCoeff--;)
+            d[j] = d[j] * u + c[iCoeff];
+        }
+        // Convert these values to forward differences
+        for (int k = 1; k < nbCoeff; ++k)
+          for (int j = that->_order; j >= k; --j)
+            d[j] -= d[j - 1];
+      }
+    }
+    // Loop on dimension
+    for (int dim = that->_dim; dim--;) {
+      double* d = diff + dim * nbCoeff;
+      // Set the value of the current point
+      res[iPoint * that->_dim + dim] = d[0];
+      // Step the differences to the next point
+      for (int k = 0; k < that->_order; ++k)
+        d[k] += d[k + 1];
     }
-    // Add the segment
-    GSetPush(&(that->_seg), seg);
   }
-  // Return the new SCurve
-  return that;
 }
 
-// Clone the SCurve
-SCurve* SCurveClone(const SCurve* const that) {
+// Get the values of the BCurve 'that' at 'nbPoint' parameters 
+// uniformly distributed over [0.0, 1.0] (both included) and store 
+// them point by point in the array 'res' allocated by the user with 
+// at least 'nbPoint' * _dim floats
+// 'nbPoint' must be at least 2
+// No memory allocation occurs
+void BCurveTessellate(const BCurve* const that, const long nbPoint, 
+  float* const res) {
 #if BUILDMODE == 0
   if (that == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
     sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (nbPoint < 2) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'nbPoint' is invalid (%ld>=2)", nbPoint);
+    PBErrCatch(BCurveErr);
+  }
 #endif
-  SCurve* clone = SCurveCreate(SCurveGetOrder(that), SCurveGetDim(that),
-    SCurveGetNbSeg(that));
-  // For each control point
-  GSetIterForward iter = GSetIterForwardCreateStatic(&(that->_ctrl));
-  GSetIterForward iterClone = 
-    GSetIterForwardCreateStatic(&(clone->_ctrl));
-  do {
-    VecFloat* ctrl = GSetIterGet(&iter);
-    VecFloat* ctrlClone = GSetIterGet(&iterClone);
-    VecCopy(ctrlClone, ctrl);
-  } while (GSetIterStep(&iter) && GSetIterStep(&iterClone));
-  return clone;
+  BCurveTessellateStep(that, 0.0, 1.0 / (float)(nbPoint - 1), nbPoint, 
+    res);
 }
 
-// Return a new SCurve as a copy of the SCurve 'that' with 
-// dimension changed to 'dim'
-// if it is extended, the values of new components are 0.0
-// If it is shrinked, values are discarded from the end of the vectors
-SCurve* SCurveGetNewDim(const SCurve* const that, const int dim) {
+// Tessellate the BCurve 'that' into a polyline whose distance to the 
+// curve is less than 'tol', and store its points point by point in 
+// the array 'res' allocated by the user with at least 'nbMax' * _dim 
+// floats
+// The BCurve is subdivided recursively (De Casteljau algorithm at 0.5)
+// until the control points of each part are at most at distance 'tol'
+// from the chord of the part, or the depth of subdivision reaches 
+// BCURVE_ADAPTIVEMAXDEPTH
+// Return the number of points of the polyline, if it's greater than 
+// 'nbMax' only the first 'nbMax' points are stored
+// No memory allocation occurs
+long BCurveTessellateAdaptive(const BCurve* const that, const float tol,
+  float* const res, const long nbMax) {
 #if BUILDMODE == 0
   if (that == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
     sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
-  if (dim <= 0) {
-    PBMathErr->_type = PBErrTypeInvalidArg;
-    sprintf(PBMathErr->_msg, "'dim' is invalid match (%d>0)", dim);
-    PBErrCatch(PBMathErr);
+  if (tol <= 0.0) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'tol' is invalid (%f>0)", tol);
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
   }
 #endif
-  // If the new dimension is equals to the current one
-  if (SCurveGetDim(that) == dim) {
-    // Return the clone of the initial curve
-    return SCurveClone(that);
-  } else {
+  // Get the control points in one array
+  float ctrl[(that->_order + 1) * that->_dim];
+  for (int iCtrl = that->_order + 1; iCtrl--;)
+    for (int iDim = that->_dim; iDim--;)
+      ctrl[iCtrl * that->_dim + iDim] = VecGet(that->_ctrl[iCtrl], iDim);
+  // Tessellate the BCurve
+  return _BCurveTessellateAdaptive(ctrl, that->_order, that->_dim, tol,
+    false, res, nbMax, NULL, NULL);
+}
+
+// Tessellate the BCurve 'that' as BCurveTessellateAdaptive and give 
+// the points one after the other to the function 'fun' with the user 
+// data 'data'
+// Return the number of points of the polyline
+// No memory allocation occurs
+long BCurveTessellateAdaptiveFun(const BCurve* const that, 
+  const float tol, BCurvePointFun fun, void* const data) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (tol <= 0.0) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'tol' is invalid (%f>0)", tol);
+    PBErrCatch(BCurveErr);
+  }
+  if (fun == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'fun' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Get the control points in one array
+  float ctrl[(that->_order + 1) * that->_dim];
+  for (int iCtrl = that->_order + 1; iCtrl--;)
+    for (int iDim = that->_dim; iDim--;)
+      ctrl[iCtrl * that->_dim + iDim] = VecGet(that->_ctrl[iCtrl], iDim);
+  // Tessellate the BCurve
+  return _BCurveTessellateAdaptive(ctrl, that->_order, that->_dim, tol,
+    false, NULL, 0, fun, data);
+}
+
+// Tessellate the control points 'ctrl' of a BCurve of order 'order' 
+// and dimension 'dim' (cf BCurveTessellateAdaptive), skipping its first
+// point if 'skipFirst' is true
+// The points are stored in 'res' up to 'nbMax' points if 'res' is not 
+// null, and given to 'fun' with 'data' if 'fun' is not null
+// Return the number of points of the polyline
+long _BCurveTessellateAdaptive(const float* const ctrl, const int order, 
+  const int dim, const float tol, const bool skipFirst, 
+  float* const res, const long nbMax, BCurvePointFun fun, 
+  void* const data) {
+#if BUILDMODE == 0
+  if (ctrl == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'ctrl' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  int nbCtrl = order + 1;
+  int size = nbCtrl * dim;
+  long nbPoint = 0;
+  // Declare a stack of parts of the curve waiting to be processed, 
+  // there are never more than one waiting part per depth
+  float stack[(BCURVE_ADAPTIVEMAXDEPTH + 1) * size];
+  int depth[BCURVE_ADAPTIVEMAXDEPTH + 1];
+  int nbStack = 1;
+  memcpy(stack, ctrl, sizeof(float) * size);
+  depth[0] = 0;
+  // Add the first point
+  if (skipFirst == false) {
+    if (res != NULL && nbPoint < nbMax)
+      memcpy(res, ctrl, sizeof(float) * dim);
+    if (fun != NULL)
+      fun(ctrl, data);
+    ++nbPoint;
+  }
+  // If the curve is reduced to one point there is nothing else to add
+  if (order == 0)
+    return nbPoint;
+  float tol2 = tol * tol;
+  // Loop until all the parts have been processed
+  while (nbStack > 0) {
+    float* part = stack + (nbStack - 1) * size;
+    const float* first = part;
+    const float* last = part + order * dim;
+    // Get the squared length of the chord of the part
+    float chord2 = 0.0;
+    for (int iDim = dim; iDim--;)
+      chord2 += (last[iDim] - first[iDim]) * (last[iDim] - first[iDim]);
+    // Check if the inner control points are close enough to the chord
+    bool flat = true;
+    for (int iCtrl = 1; iCtrl < order && flat; ++iCtrl) {
+      const float* p = part + iCtrl * dim;
+      float t = 0.0;
+      if (chord2 > 0.0) {
+        for (int iDim = dim; iDim--;)
+          t += (p[iDim] - first[iDim]) * (last[iDim] - first[iDim]);
+        t = MIN(MAX(t / chord2, 0.0), 1.0);
+      }
+      float dist2 = 0.0;
+      for (int iDim = dim; iDim--;) {
+        float d = p[iDim] - first[iDim] - t * (last[iDim] - first[iDim]);
+        dist2 += d * d;
+      }
+      if (dist2 > tol2)
+        flat = false;
+    }
+    // If the part is flat enough or can't be subdivided anymore
+    if (flat == true || depth[nbStack - 1] == BCURVE_ADAPTIVEMAXDEPTH) {
+      // Add the last point of the part and remove it from the stack
+      if (res != NULL && nbPoint < nbMax)
+        memcpy(res + nbPoint * dim, last, sizeof(float) * dim);
+      if (fun != NULL)
+        fun(last, data);
+      ++nbPoint;
+      --nbStack;
+    // Else, the part must be subdivided
+    } else {
+      // Split the part at 0.5 with the De Casteljau algorithm, the 
+      // right half replaces the part and the left half is pushed on top 
+      // of it to be processed first
+      float* left = part + size;
+      for (int iDim = dim; iDim--;) {
+        for (int subOrder = order; subOrder > 0; --subOrder) {
+          left[(order - subOrder) * dim + iDim] = part[iDim];
+          for (int iCtrl = 0; iCtrl < subOrder; ++iCtrl)
+            part[iCtrl * dim + iDim] = 0.5 * 
+              (part[iCtrl * dim + iDim] + part[(iCtrl + 1) * dim + iDim]);
+        }
+        left[order * dim + iDim] = part[iDim];
+      }
+      depth[nbStack - 1] += 1;
+      depth[nbStack] = depth[nbStack - 1];
+      ++nbStack;
+    }
+  }
+  // Return the number of points
+  return nbPoint;
+}
+
+// Create a BCurve which pass through the points given in the GSet 'set'
+// The GSet must contains VecFloat of same dimensions
+// The BCurve pass through the points in the order they are given
+// in the GSet. The points don't need to be uniformly distributed
+// The created BCurve is of same dimension as the VecFloat and of order 
+// equal to the number of VecFloat in 'set' minus one
+// Return NULL if it couldn't create the BCurve
+BCurve* BCurveFromCloudPoint(const GSetVecFloat* const set) {
+#if BUILDMODE == 0
+  if (set == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'set' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (GSetNbElem(set) < 1) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'set' is empty");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Declare a variable to memorize the result
+  int order = GSetNbElem(set) - 1;
+  long dim = VecGetDim(GSetHead(set));
+  BCurve* curve = BCurveCreate(order, dim);
+  // Set the first control point to the first point in the point cloud
+  BCurveSetCtrl(curve, 0, GSetHead(set));
+  // If the order is greater than 0
+  if (order > 0) {
+    // Set the last control point to the last point in the point cloud
+    BCurveSetCtrl(curve, order, GSetTail(set));
+    // If the order is greater than 1
+    if (order > 1) {
+      // Get the points in an array for direct access and calculate the
+      // t values for intermediate control points
+      // They are equal to the relative distance on the polyline
+      // linking the point in the point cloud
+      VecFloat** points = 
+        PBErrMalloc(BCurveErr, sizeof(VecFloat*) * (order + 1));
+      float* t = PBErrMalloc(BCurveErr, sizeof(float) * (order + 1));
+      GSetIterForward iter = GSetIterForwardCreateStatic(set);
+      int iPoint = 0;
+      do {
+        points[iPoint] = GSetIterGet(&iter);
+        t[iPoint] = (iPoint == 0 ? 0.0 :
+          t[iPoint - 1] + VecDist(points[iPoint - 1], points[iPoint]));
+        ++iPoint;
+      } while(GSetIterStep(&iter));
+      // Normalize t
+      for (iPoint = 1; iPoint <= order; ++iPoint)
+        t[iPoint] /= t[order];
+      // Declare the matrix and the right hand sides of the linear 
+      // system, the matrix depends only on the t values so the system
+      // is solved once for all the dimensions
+      int nb = order - 1;
+      double* mat = PBErrMalloc(BCurveErr, sizeof(double) * nb * nb);
+      double* rhs = PBErrMalloc(BCurveErr, sizeof(double) * nb * dim);
+      // For each line (equivalent to each intermediate point 
+      // in point cloud)
+      for (int iRow = nb; iRow--;) {
+        // Get the weight of the control point at the value 
+        // of t for this point
+        VecFloat* weight = BCurveGetWeightCtrlPt(curve, t[iRow + 1]);
+        // Set the matrix values with the weights of the intermediate
+        // control points
+        for (int iCol = nb; iCol--;)
+          mat[iRow * nb + iCol] = weight->_val[iCol + 1];
+        // Set the right hand sides with the corresponding point
+        // coordinates minus the contribution of the first and last 
+        // control points
+        for (long iDim = dim; iDim--;)
+          rhs[iRow * dim + iDim] = points[iRow + 1]->_val[iDim] -
+            weight->_val[0] * points[0]->_val[iDim] - 
+            weight->_val[order] * points[order]->_val[iDim];
+        // Free memory
+        VecFree(&weight);
+      }
+      // Solve the system
+      bool ret = _BCurveSolveLinSys(mat, nb, rhs, dim);
+      // If we could solve the linear system
+      if (ret == true) {
+        // Memorize the values of intermediate control points
+        for (int iCtrl = 1; iCtrl < order; ++iCtrl)
+          for (long iDim = dim; iDim--;)
+            curve->_ctrl[iCtrl]->_val[iDim] = 
+              rhs[(iCtrl - 1) * dim + iDim];
+      }
+      // Free memory
+      free(rhs);
+      free(mat);
+      free(t);
+      free(points);
+      // If we couldn't solve the linear system
+      if (ret == false) {
+        BCurveFree(&curve);
+        // Return NULL
+        return NULL;
+      }
+    }
+  }
+  // Return the result
+  return curve;
+}
+
+// Create a BCurve of order 'order' approximating the points given in
+// the GSet 'set'
+// The GSet must contains VecFloat of same dimensions
+// The BCurve starts at the first point and ends at the last point of
+// 'set', the other control points are calculated by least squares 
+// with the points parameterized by their relative distance on the 
+// polyline linking them, as in BCurveFromCloudPoint
+// The cost is linear in the number of points
+// Return NULL if it couldn't create the BCurve
+BCurve* BCurveFromCloudPointOrder(const GSetVecFloat* const set, 
+  const int order) {
+#if BUILDMODE == 0
+  if (set == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'set' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (GSetNbElem(set) < 2) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'set' has less than 2 points");
+    PBErrCatch(BCurveErr);
+  }
+  if (order < 1) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'order' is invalid (%d>0)", order);
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Get the points in an array for direct access
+  long nbPoint = GSetNbElem(set);
+  const VecFloat** points = 
+    PBErrMalloc(BCurveErr, sizeof(VecFloat*) * nbPoint);
+  GSetIterForward iter = GSetIterForwardCreateStatic(set);
+  long iPoint = 0;
+  do {
+    points[iPoint++] = GSetIterGet(&iter);
+  } while (GSetIterStep(&iter));
+  // Create the curve and fit its control points
+  BCurve* curve = BCurveCreate(order, VecGetDim(points[0]));
+  bool ret = _BCurveFitCtrl(points, nbPoint, NULL, order, 1, 
+    curve->_ctrl);
+  // Free memory
+  free(points);
+  // If we couldn't fit the control points
+  if (ret == false)
+    BCurveFree(&curve);
+  // Return the result
+  return curve;
+}
+
+// Calculate by least squares the control points 'ctrl' of 'nbSeg' 
+// consecutive Bezier curves of order 'order' approximating the 
+// 'nbPoint' points 'points' (of same dimension as 'ctrl')
+// 'ctrl' is the array of the 'nbSeg' * 'order' + 1 control points, 
+// the last control point of a segment being the first one of the next
+// segment
+// If 't' is not null it gives the parameters of the points in [0,1], 
+// in increasing order, else the points are parameterized by their 
+// relative distance on the polyline linking them. The parameters are
+// split uniformly between the segments
+// The first and last control points are set to the first and last 
+// points. A small penalty on the distance between consecutive control
+// points, weighted by BCURVE_FITSMOOTH, keeps the system solvable when
+// some segments have too few points
+// The normal equations are accumulated in O(nbPoint * order^2) and 
+// solved in O(nbSeg * order^3) thanks to their band structure
+// Return false if the system couldn't be solved, in which case 'ctrl'
+// is left unchanged
+bool _BCurveFitCtrl(const VecFloat* const* const points, 
+  const long nbPoint, const float* const t, const int order, 
+  const int nbSeg, VecFloat** const ctrl) {
+#if BUILDMODE == 0
+  if (points == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'points' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (ctrl == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'ctrl' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (nbPoint < 2) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'nbPoint' is invalid (%ld>1)", nbPoint);
+    PBErrCatch(BCurveErr);
+  }
+  if (order < 1 || nbSeg < 1) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, 
+      "'order' or 'nbSeg' is invalid (%d>0, %d>0)", order, nbSeg);
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  int dim = VecGetDim(points[0]);
+  int nbCtrl = nbSeg * order + 1;
+  // The unknowns are the intermediate control points
+  int nb = nbCtrl - 2;
+  // If there is no unknown, set the first and last control points
+  if (nb == 0) {
+    VecCopy(ctrl[0], points[0]);
+    VecCopy(ctrl[1], points[nbPoint - 1]);
+    return true;
+  }
+  // Get the parameters of the points, by default their relative 
+  // distance on the polyline
+  float* param = NULL;
+  const float* u = t;
+  if (u == NULL) {
+    param = PBErrMalloc(BCurveErr, sizeof(float) * nbPoint);
+    param[0] = 0.0;
+    for (long iPoint = 1; iPoint < nbPoint; ++iPoint)
+      param[iPoint] = param[iPoint - 1] + 
+        VecDist(points[iPoint - 1], points[iPoint]);
+    for (long iPoint = 1; iPoint < nbPoint; ++iPoint)
+      param[iPoint] = (param[nbPoint - 1] > PBMATH_EPSILON ? 
+        param[iPoint] / param[nbPoint - 1] : 
+        (float)iPoint / (float)(nbPoint - 1));
+    u = param;
+  }
+  // Declare the normal equations, the matrix is symmetric and 
+  // stored as its upper band of half width 'order'
+  double* band = 
+    PBErrMalloc(BCurveErr, sizeof(double) * nb * (order + 1));
+  memset(band, 0, sizeof(double) * nb * (order + 1));
+  double* rhs = PBErrMalloc(BCurveErr, sizeof(double) * nb * dim);
+  memset(rhs, 0, sizeof(double) * nb * dim);
+  // Accumulate the points
+  float w[order + 1];
+  for (long iPoint = 0; iPoint < nbPoint; ++iPoint) {
+    // Get the segment and local parameter of the point
+    float v = u[iPoint] * (float)nbSeg;
+    int iSeg = MIN(nbSeg - 1, MAX(0, (int)floor(v)));
+    float tLocal = MIN(1.0, MAX(0.0, v - (float)iSeg));
+    // Get the Bernstein weights of the control points of the segment
+    _BCurveGetWeightOrderN(order, tLocal, w);
+    _BCurveFitAccumulate(band, rhs, order, nb, dim, iSeg * order, 
+      order + 1, w, points[iPoint]->_val, points[0]->_val, 
+      points[nbPoint - 1]->_val);
+  }
+  // Accumulate the penalty on the differences between consecutive 
+  // control points
+  float smooth = sqrt(BCURVE_FITSMOOTH * (float)nbPoint / (float)nb);
+  float coeff[2] = {smooth, -smooth};
+  float zero[dim];
+  memset(zero, 0, sizeof(float) * dim);
+  for (int iCtrl = 1; iCtrl < nbCtrl; ++iCtrl)
+    _BCurveFitAccumulate(band, rhs, order, nb, dim, iCtrl - 1, 2, 
+      coeff, zero, points[0]->_val, points[nbPoint - 1]->_val);
+  // Solve the normal equations
+  bool ret = _BCurveSolveBandSys(band, nb, order, rhs, dim);
+  // If we could solve the system, update the control points
+  if (ret == true) {
+    VecCopy(ctrl[0], points[0]);
+    VecCopy(ctrl[nbCtrl - 1], points[nbPoint - 1]);
+    for (int iCtrl = nb; iCtrl--;)
+      for (int iDim = dim; iDim--;)
+        ctrl[iCtrl + 1]->_val[iDim] = rhs[iCtrl * dim + iDim];
+  }
+  // Free memory
+  free(rhs);
+  free(band);
+  if (param != NULL)
+    free(param);
+  // Return the success flag
+  return ret;
+}
+
+// Solve the linear system 'mat'.x = 'rhs' of 'nb' equations for
+// 'nbRhs' right hand sides at once by Gaussian elimination with partial
+// pivoting, so the matrix is factorized only once
+// 'mat' is a 'nb' x 'nb' matrix and 'rhs' a 'nb' x 'nbRhs' matrix, 
+// both stored by rows. They are modified, and the solutions are stored
+// in 'rhs' on return
+// Return false if the system is singular (cf BCURVE_LINSYSEPS)
+bool _BCurveSolveLinSys(double* const mat, const int nb, 
+  double* const rhs, const int nbRhs) {
+#if BUILDMODE == 0
+  if (mat == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'mat' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (rhs == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'rhs' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Get the threshold on the pivots relative to the scale of 'mat'
+  double eps = 0.0;
+  for (int i = nb * nb; i--;)
+    eps = MAX(eps, fabs(mat[i]));
+  eps *= BCURVE_LINSYSEPS;
+  // For each column
+  for (int iCol = 0; iCol < nb; ++iCol) {
+    // Search the pivot
+    int iPivot = iCol;
+    for (int iRow = iCol + 1; iRow < nb; ++iRow)
+      if (fabs(mat[iRow * nb + iCol]) > fabs(mat[iPivot * nb + iCol]))
+        iPivot = iRow;
+    if (fabs(mat[iPivot * nb + iCol]) <= eps)
+      return false;
+    // Swap the rows
+    if (iPivot != iCol) {
+      for (int i = nb; i--;) {
+        double tmp = mat[iCol * nb + i];
+        mat[iCol * nb + i] = mat[iPivot * nb + i];
+        mat[iPivot * nb + i] = tmp;
+      }
+      for (int i = nbRhs; i--;) {
+        double tmp = rhs[iCol * nbRhs + i];
+        rhs[iCol * nbRhs + i] = rhs[iPivot * nbRhs + i];
+        rhs[iPivot * nbRhs + i] = tmp;
+      }
+    }
+    // Eliminate the column in the following rows
+    for (int iRow = iCol + 1; iRow < nb; ++iRow) {
+      double coeff = mat[iRow * nb + iCol] / mat[iCol * nb + iCol];
+      if (coeff == 0.0)
+        continue;
+      for (int i = iCol + 1; i < nb; ++i)
+        mat[iRow * nb + i] -= coeff * mat[iCol * nb + i];
+      for (int i = nbRhs; i--;)
+        rhs[iRow * nbRhs + i] -= coeff * rhs[iCol * nbRhs + i];
+    }
+  }
+  // Back substitution
+  for (int iRow = nb; iRow--;) {
+    for (int i = nbRhs; i--;) {
+      double v = rhs[iRow * nbRhs + i];
+      for (int iCol = iRow + 1; iCol < nb; ++iCol)
+        v -= mat[iRow * nb + iCol] * rhs[iCol * nbRhs + i];
+      rhs[iRow * nbRhs + i] = v / mat[iRow * nb + iRow];
+    }
+  }
+  // Return the success flag
+  return true;
+}
+
+// Solve the linear system 'mat'.x = 'rhs' of 'nb' equations for
+// 'nbRhs' right hand sides at once, where 'mat' is a symmetric 
+// definite positive band matrix of half width 'hw', by Cholesky 
+// factorization in O('nb' * 'hw'^2)
+// 'band' is the upper band of 'mat', 'band'[i * ('hw' + 1) + j] is 
+// 'mat'[i][i + j], 'rhs' is a 'nb' x 'nbRhs' matrix stored by rows. 
+// They are modified, and the solutions are stored in 'rhs' on return
+// Return false if the matrix is not definite positive (cf 
+// BCURVE_LINSYSEPS)
+bool _BCurveSolveBandSys(double* const band, const int nb, 
+  const int hw, double* const rhs, const int nbRhs) {
+#if BUILDMODE == 0
+  if (band == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'band' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (rhs == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'rhs' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  int w = hw + 1;
+  // Get the threshold on the pivots relative to the scale of 'mat', 
+  // the largest value of a definite positive matrix being on its 
+  // diagonal
+  double eps = 0.0;
+  for (int i = nb; i--;)
+    eps = MAX(eps, band[i * w]);
+  eps *= BCURVE_LINSYSEPS;
+  // Factorize 'mat' into U^t.U, U replacing the band
+  for (int i = 0; i < nb; ++i) {
+    for (int j = i; j < nb && j <= i + hw; ++j) {
+      double sum = band[i * w + j - i];
+      for (int k = MAX(0, j - hw); k < i; ++k)
+        sum -= band[k * w + i - k] * band[k * w + j - k];
+      if (j == i) {
+        if (sum <= eps)
+          return false;
+        band[i * w] = sqrt(sum);
+      } else {
+        band[i * w + j - i] = sum / band[i * w];
+      }
+    }
+  }
+  // Solve U^t.y = 'rhs'
+  for (int i = 0; i < nb; ++i) {
+    for (int iRhs = nbRhs; iRhs--;) {
+      double v = rhs[i * nbRhs + iRhs];
+      for (int k = MAX(0, i - hw); k < i; ++k)
+        v -= band[k * w + i - k] * rhs[k * nbRhs + iRhs];
+      rhs[i * nbRhs + iRhs] = v / band[i * w];
+    }
+  }
+  // Solve U.x = y
+  for (int i = nb; i--;) {
+    for (int iRhs = nbRhs; iRhs--;) {
+      double v = rhs[i * nbRhs + iRhs];
+      for (int j = i + 1; j < nb && j <= i + hw; ++j)
+        v -= band[i * w + j - i] * rhs[j * nbRhs + iRhs];
+      rhs[i * nbRhs + iRhs] = v / band[i * w];
+    }
+  }
+  // Return the success flag
+  return true;
+}
+
+// Get a VecFloat of dimension equal to the number of control points
+// Values of the VecFloat are the weight of each control point in the 
+// BCurve given the curve's order and the value of 't' (in [0.0,1.0])
+VecFloat* BCurveGetWeightCtrlPt(const BCurve* const that, 
+  const float t) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Declare a variable to memorize the result
+  VecFloat* res = VecFloatCreate(that->_order + 1);
+  // If there is an unrolled calculation for this order
+  switch (that->_order) {
+    case 1:
+      _BCurveGetWeightOrder1(t, res->_val);
+      return res;
+    case 2:
+      _BCurveGetWeightOrder2(t, res->_val);
+      return res;
+    case 3:
+      _BCurveGetWeightOrder3(t, res->_val);
+      return res;
+    default:
+      break;
+  }
+  // Initilize the two first weights
+  VecSet(res, 0, 1.0 - t);
+  VecSet(res, 1, t);
+  // For each higher order
+  for (int order = 1; order < that->_order; ++order) {
+    // For each control point at this order, starting by the last one
+    // to avoid using a temporary buffer
+    for (int iCtrl = order + 2; iCtrl-- && iCtrl != 0;)
+      // Calculate the weight of this control point
+      VecSet(res, iCtrl, 
+        (1.0 - t) * VecGet(res, iCtrl) + t * VecGet(res, iCtrl - 1));
+    // Calculate the weight of the first control point
+    VecSet(res, 0, (1.0 - t) * VecGet(res, 0));
+  }
+  // Return the result
+  return res;
+}
+
+// Get the bounding box of the BCurve.
+// Return a Facoid whose axis are aligned on the standard coordinate 
+// system.
+Facoid* BCurveGetBoundingBox(const BCurve* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  float bound[2 * that->_dim];
+  BCurveGetBound(that, false, bound);
+  return _BCurveBoundToFacoid(bound, that->_dim);
+}
+
+// Get the tight bounding box of the BCurve, calculated from the 
+// extrema of the curve instead of its control points
+// Return a Facoid whose axis are aligned on the standard coordinate 
+// system.
+Facoid* BCurveGetTightBoundingBox(const BCurve* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  float bound[2 * that->_dim];
+  BCurveGetBound(that, true, bound);
+  return _BCurveBoundToFacoid(bound, that->_dim);
+}
+
+// Get the bounding box of the BCurve 'that' and store it in the array
+// 'res' allocated by the user with 2 * _dim floats (minimum values 
+// followed by maximum values)
+// If 'tight' is true the bounding box of the curve is calculated, 
+// else the one of its control points
+// No memory allocation occurs
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
+void BCurveGetBound(const BCurve* const that, const bool tight, 
+  float* const res) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Calculate the bounding box if it's not in the cache
+  float** cache = (float**)(tight ? &(that->_tightBound) : 
+    &(that->_bound));
+  if (*cache == NULL) {
+    *cache = PBErrMalloc(BCurveErr, sizeof(float) * 2 * that->_dim);
+    _BCurveGetBoundCtrl(that->_ctrl, that->_order, that->_dim, tight, 
+      *cache);
+  }
+  // Copy the bounding box from the cache
+  memcpy(res, *cache, sizeof(float) * 2 * that->_dim);
+}
+
+// Get the bounding box of the Bezier curve of order 'order' and 
+// dimension 'dim' with control points 'ctrl' and store it in the 
+// array 'res' (cf BCurveGetBound)
+void _BCurveGetBoundCtrl(VecFloat* const* const ctrl, const int order,
+  const int dim, const bool tight, float* const res) {
+  // Loop on dimension
+  for (int iDim = dim; iDim--;) {
+    float val[order + 1];
+    for (int iCtrl = order + 1; iCtrl--;)
+      val[iCtrl] = ctrl[iCtrl]->_val[iDim];
+    res[iDim] = val[0];
+    res[dim + iDim] = val[0];
+    // If the bounding box is tight, get the range of the curve, else
+    // the range of its control points
+    if (tight) {
+      _BCurveGetBoundScalar(val, order, res + iDim, res + dim + iDim);
+    } else {
+      for (int iCtrl = order + 1; iCtrl--;) {
+        res[iDim] = MIN(res[iDim], val[iCtrl]);
+        res[dim + iDim] = MAX(res[dim + iDim], val[iCtrl]);
+      }
+    }
+  }
+}
+
+// Update the range ['min','max'] with the range of the Bezier 
+// polynomial of order 'order' and coefficients 'val', from the roots
+// of its derivative (in closed form up to order 3, by subdivision 
+// above), widened by BCURVE_BOUNDEPS relative to the range of the 
+// coefficients to stay conservative despite the rounding errors
+void _BCurveGetBoundScalar(const float* const val, const int order, 
+  float* const min, float* const max) {
+  // The end points are on the curve
+  *min = MIN(*min, MIN(val[0], val[order]));
+  *max = MAX(*max, MAX(val[0], val[order]));
+  if (order < 2)
+    return;
+  // Get the range of the coefficients, which contains the range of 
+  // the polynomial
+  float lo = val[0];
+  float hi = val[0];
+  for (int iCtrl = order + 1; iCtrl--;) {
+    lo = MIN(lo, val[iCtrl]);
+    hi = MAX(hi, val[iCtrl]);
+  }
+  float tol = BCURVE_BOUNDEPS * (hi - lo);
+  // Above order 3, use the subdivision
+  if (order > 3) {
+    float scratch[2 * BCURVE_BOUNDMAXDEPTH * (order + 1)];
+    _BBodyGetBoundScalar(val, order, 1, tol, 0, min, max, scratch);
+    return;
+  }
+  // Get the roots in ]0,1[ of the derivative, whose coefficients are,
+  // up to a factor, the differences of consecutive coefficients
+  float d[3];
+  for (int iCtrl = order; iCtrl--;)
+    d[iCtrl] = val[iCtrl + 1] - val[iCtrl];
+  float roots[2];
+  int nbRoot = 0;
+  if (order == 2) {
+    if (d[0] != d[1])
+      roots[nbRoot++] = d[0] / (d[0] - d[1]);
+  } else {
+    // Convert the derivative to power basis a.t^2 + b.t + c
+    float a = d[0] - 2.0 * d[1] + d[2];
+    float b = 2.0 * (d[1] - d[0]);
+    float c = d[0];
+    if (fabs(a) <= PBMATH_EPSILON * (fabs(b) + fabs(c))) {
+      if (b != 0.0)
+        roots[nbRoot++] = -c / b;
+    } else {
+      float disc = b * b - 4.0 * a * c;
+      if (disc >= 0.0) {
+        float sq = sqrt(disc);
+        roots[nbRoot++] = (-b - sq) / (2.0 * a);
+        roots[nbRoot++] = (-b + sq) / (2.0 * a);
+      }
+    }
+  }
+  // Update the range with the value at the roots, widened by the 
+  // tolerance and kept inside the range of the coefficients
+  for (int iRoot = nbRoot; iRoot--;) {
+    float t = roots[iRoot];
+    if (t > 0.0 && t < 1.0) {
+      float v[4];
+      memcpy(v, val, sizeof(float) * (order + 1));
+      for (int subOrder = order; subOrder > 0; --subOrder)
+        for (int iCtrl = 0; iCtrl < subOrder; ++iCtrl)
+          v[iCtrl] = (1.0 - t) * v[iCtrl] + t * v[iCtrl + 1];
+      *min = MIN(*min, MAX(lo, v[0] - tol));
+      *max = MAX(*max, MIN(hi, v[0] + tol));
+    }
+  }
+}
+
+// Create a Facoid whose axis are aligned on the standard coordinate 
+// system from the bounding box 'bound' of dimension 'dim' (minimum 
+// values followed by maximum values)
+Facoid* _BCurveBoundToFacoid(const float* const bound, const int dim) {
+  Facoid* res = FacoidCreate(dim);
+  for (int iDim = dim; iDim--;) {
+    ShapoidPosSet(res, iDim, bound[iDim]);
+    float d = bound[dim + iDim] - bound[iDim];
+    if (d < PBMATH_EPSILON)
+      d = 2.0 * PBMATH_EPSILON;
+    ShapoidAxisSet(res, iDim, iDim, d);
+  }
+  return res;
+}
+
+// -------------- SCurve
+
+// ================ Functions implementation ====================
+
+// Create a new SCurve of dimension 'dim', order 'order' and 
+// 'nbSeg' segments
+SCurve* SCurveCreate(const int order, const int dim, const int nbSeg) {
+#if BUILDMODE == 0
+  if (order < 0) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "Invalid order (%d>=0)", order);
+    PBErrCatch(BCurveErr);
+  }
+  if (dim < 1) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "Invalid dimension (%d>=1)", dim);
+    PBErrCatch(BCurveErr);
+  }
+  if (nbSeg < 1) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "Invalid number of segment (%d>=1)", nbSeg);
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Allocate memory
+  SCurve* that = PBErrMalloc(BCurveErr, sizeof(SCurve));
+  // Set the values
+  int* d = (int*)&(that->_dim);
+  *d = dim;
+  int* o = (int*)&(that->_order);
+  *o = order;
+  that->_nbSeg = 0;
+  // Get the size of one control point in the block of control points, 
+  // rounded up to keep the alignment of the next one
+  that->_sizeCtrl = sizeof(VecFloat) + sizeof(float) * dim;
+  that->_sizeCtrl = (that->_sizeCtrl + _Alignof(VecFloat) - 1) / 
+    _Alignof(VecFloat) * _Alignof(VecFloat);
+  // Allocate the control points and the segments
+  that->_ctrlBlock = NULL;
+  that->_ctrlArr = NULL;
+  that->_segArr = NULL;
+  that->_capSeg = 0;
+  that->_iHead = 0;
+  that->_arcLen = NULL;
+  that->_bvh = NULL;
+  that->_bvhDirty = false;
+  that->_bound = NULL;
+  that->_tightBound = NULL;
+  that->_center = NULL;
+  _SCurveReserve(that, 0, nbSeg);
+  that->_nbSeg = nbSeg;
+  // Create the GSet
+  that->_ctrl = GSetVecFloatCreateStatic();
+  that->_seg = GSetBCurveCreateStatic();
+  // Add the segments and control points to the sets
+  for (int iSeg = 0; iSeg < nbSeg; ++iSeg)
+    GSetAppend(&(that->_seg), that->_segArr + iSeg);
+  for (int iCtrl = 0; iCtrl < SCurveGetNbCtrl(that); ++iCtrl)
+    GSetAppend(&(that->_ctrl), that->_ctrlArr[iCtrl]);
+  // Return the new SCurve
+  return that;
+}
+
+// Clone the SCurve
+SCurve* SCurveClone(const SCurve* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  SCurve* clone = SCurveCreate(SCurveGetOrder(that), SCurveGetDim(that),
+    SCurveGetNbSeg(that));
+  // Copy the control points, which are stored contiguously
+  memcpy(clone->_ctrlArr[0], 
+    that->_ctrlArr[that->_iHead * that->_order], 
+    that->_sizeCtrl * SCurveGetNbCtrl(that));
+  return clone;
+}
+
+// Return a new SCurve as a copy of the SCurve 'that' with 
+// dimension changed to 'dim'
+// if it is extended, the values of new components are 0.0
+// If it is shrinked, values are discarded from the end of the vectors
+SCurve* SCurveGetNewDim(const SCurve* const that, const int dim) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (dim <= 0) {
+    PBMathErr->_type = PBErrTypeInvalidArg;
+    sprintf(PBMathErr->_msg, "'dim' is invalid match (%d>0)", dim);
+    PBErrCatch(PBMathErr);
+  }
+#endif
+  // If the new dimension is equals to the current one
+  if (SCurveGetDim(that) == dim) {
+    // Return the clone of the initial curve
+    return SCurveClone(that);
+  } else {
     // Clone the initial curve
     SCurve* ret = 
       SCurveCreate(SCurveGetOrder(that), dim, SCurveGetNbSeg(that));
@@ -611,781 +1695,2896 @@ SCurve* SCurveGetNewDim(const SCurve* const that, const int dim) {
     GSetIterForward iterNew = 
       GSetIterForwardCreateStatic(&(ret->_ctrl));
     do {
-      VecFloat* newCtrl = 
-        VecGetNewDim((VecFloat*)GSetIterGet(&iter), dim);
-      VecCopy((VecFloat*)(GSetIterGetElem(&iterNew)->_data), newCtrl);
-      VecFree(&newCtrl);
-    } while (GSetIterStep(&iter) && GSetIterStep(&iterNew));
-    // Return the new curve
-    return ret;
+      VecFloat* newCtrl = 
+        VecGetNewDim((VecFloat*)GSetIterGet(&iter), dim);
+      VecCopy((VecFloat*)(GSetIterGetElem(&iterNew)->_data), newCtrl);
+      VecFree(&newCtrl);
+    } while (GSetIterStep(&iter) && GSetIterStep(&iterNew));
+    // Return the new curve
+    return ret;
+  }
+}
+
+// Function which return the JSON encoding of 'that' 
+JSONNode* SCurveEncodeAsJSON(const SCurve* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    PBMathErr->_type = PBErrTypeNullPointer;
+    sprintf(PBMathErr->_msg, "'that' is null");
+    PBErrCatch(PBMathErr);
+  }
+#endif
+  // Create the JSON structure
+  JSONNode* json = JSONCreate();
+  // Declare a buffer to convert value into string
+  char val[100];
+  // Encode the order
+  sprintf(val, "%d", SCurveGetOrder(that));
+  JSONAddProp(json, "_order", val);
+  // Encode the dimension
+  sprintf(val, "%d", SCurveGetDim(that));
+  JSONAddProp(json, "_dim", val);
+  // Encode the nb of segment
+  sprintf(val, "%d", SCurveGetNbSeg(that));
+  JSONAddProp(json, "_nbSeg", val);
+  // Encode the control points
+  JSONArrayStruct setCtrl = JSONArrayStructCreateStatic();
+  GSetIterForward iter = GSetIterForwardCreateStatic(&(that->_ctrl));
+  do {
+    VecFloat* ctrl = (VecFloat*)GSetIterGet(&iter);
+    JSONArrayStructAdd(&setCtrl, VecEncodeAsJSON(ctrl));
+  } while (GSetIterStep(&iter));
+  JSONAddProp(json, "_ctrl", &setCtrl);
+  // Free memory
+  JSONArrayStructFlush(&setCtrl);
+  // Return the created JSON 
+  return json;
+}
+
+// Function which decode from JSON encoding 'json' to 'that'
+bool SCurveDecodeAsJSON(SCurve** that, const JSONNode* const json) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    PBMathErr->_type = PBErrTypeNullPointer;
+    sprintf(PBMathErr->_msg, "'that' is null");
+    PBErrCatch(PBMathErr);
+  }
+  if (json == NULL) {
+    PBMathErr->_type = PBErrTypeNullPointer;
+    sprintf(PBMathErr->_msg, "'json' is null");
+    PBErrCatch(PBMathErr);
+  }
+#endif
+  // If 'that' is already allocated
+  if (*that != NULL)
+    // Free memory
+    SCurveFree(that);
+  // Get the order from the JSON
+  JSONNode* prop = JSONProperty(json, "_order");
+  if (prop == NULL) {
+    return false;
+  }
+  int order = atoi(JSONLblVal(prop));
+  // Get the dimension from the JSON
+  prop = JSONProperty(json, "_dim");
+  if (prop == NULL) {
+    return false;
+  }
+  int dim = atoi(JSONLblVal(prop));
+  // Get the nb of segment from the JSON
+  prop = JSONProperty(json, "_nbSeg");
+  if (prop == NULL) {
+    return false;
+  }
+  int nbSeg = atoi(JSONLblVal(prop));
+  // If data are invalid
+  if (nbSeg < 1 || order < 0 || dim < 1)
+    return false;
+  // Allocate memory
+  *that = SCurveCreate(order, dim, nbSeg);
+  // Decode the control points
+  prop = JSONProperty(json, "_ctrl");
+  if (prop == NULL) {
+    return false;
+  }
+  if (JSONGetNbValue(prop) != SCurveGetNbCtrl(*that)) {
+    return false;
+  }
+  GSetIterForward iter = GSetIterForwardCreateStatic(&((*that)->_ctrl));
+  int iCtrl = 0;
+  do {
+    VecFloat* loadCtrl = NULL;
+    JSONNode* ctrl = JSONValue(prop, iCtrl);
+    if (!VecDecodeAsJSON(&loadCtrl, ctrl) || 
+      VecGetDim(loadCtrl) != dim) {
+      return false;
+    }
+    // Set the loaded control point into the set of control point
+    // and segment
+    VecCopy((VecFloat*)GSetIterGet(&iter), loadCtrl);
+    // Free memory used by the loaded control
+    VecFree(&loadCtrl);
+    ++iCtrl;
+  } while (GSetIterStep(&iter));
+  // Return the success code
+  return true;
+}
+
+// Load the SCurve from the stream
+// If the SCurve is already allocated, it is freed before loading
+// Return true in case of success, false else
+bool SCurveLoad(SCurve** that, FILE* const stream) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (stream == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'stream' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Declare a json to load the encoded data
+  JSONNode* json = JSONCreate();
+  // Load the whole encoded data
+  if (!JSONLoad(json, stream)) {
+    return false;
+  }
+  // Decode the data from the JSON
+  if (!SCurveDecodeAsJSON(that, json)) {
+    return false;
+  }
+  // Free the memory used by the JSON
+  JSONFree(&json);
+  // Return the success code
+  return true;
+}
+
+// Save the SCurve to the stream
+// If 'compact' equals true it saves in compact form, else it saves in 
+// readable form
+// Return true upon success, false else
+bool SCurveSave(const SCurve* const that, FILE* const stream, 
+  const bool compact) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (stream == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'stream' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Get the JSON encoding
+  JSONNode* json = SCurveEncodeAsJSON(that);
+  // Save the JSON
+  if (!JSONSave(json, stream, compact)) {
+    return false;
+  }
+  // Free memory
+  JSONFree(&json);
+  // Return success code
+  return true;
+}
+
+// Free the memory used by a SCurve
+void SCurveFree(SCurve** that) {
+  // Check argument
+  if (that == NULL || *that == NULL)
+    return;
+  // Free the cached data of the segments and the SCurve
+  for (int iSeg = (*that)->_nbSeg; iSeg--;)
+    _BCurveInvalidateCache((*that)->_segArr + (*that)->_iHead + iSeg);
+  _SCurveInvalidateCache(*that);
+  SCurveBVHFree(&((*that)->_bvh));
+  // Free the memory used by the sets of control point and segment
+  GSetFlush(&((*that)->_ctrl));
+  GSetFlush(&((*that)->_seg));
+  // Free the memory used by the control points and segments
+  free((*that)->_ctrlBlock);
+  free((*that)->_ctrlArr);
+  free((*that)->_segArr);
+  // Free memory
+  free(*that);
+  *that = NULL;
+}
+
+// Print the SCurve on 'stream'
+void SCurvePrint(const SCurve* const that, FILE* const stream) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (stream == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'stream' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Print the order and dim
+  fprintf(stream, "order(%d) dim(%d) nbSeg(%d) ", 
+    that->_order, that->_dim, that->_nbSeg);
+  // For each control point
+  GSetIterForward iter = GSetIterForwardCreateStatic(&(that->_ctrl));
+  int iMark = 0;
+  do {
+    VecFloat* ctrl = (VecFloat*)GSetIterGet(&iter);
+    if (iMark == 0)
+      fprintf(stream, "<");
+    //VecPrint(ctrl, stream);
+    VecFloatPrint(ctrl, stream, 6);
+    if (iMark == 0)
+      fprintf(stream, ">");
+    if (GSetIterIsLast(&iter) == false) 
+      fprintf(stream, " ");
+    ++iMark;
+    if (iMark == that->_order)
+      iMark = 0;
+  } while (GSetIterStep(&iter));
+}
+
+// Add one segment at the end of the curve (controls are set to 
+// vectors null, except the first one which the last one of the current
+// last segment)
+// The segments and control points may be moved in memory, which 
+// invalidates the pointers previously obtained with SCurveSeg, 
+// SCurveCtrl, SCurveSegs, SCurveCtrls and the iterators on the 
+// SCurve or its GSets
+void SCurveAddSegTail(SCurve* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Make room for the new segment
+  _SCurveReserve(that, 0, 1);
+  // Get the new segment, its first control point is the current last 
+  // control
+  BCurve* seg = that->_segArr + that->_iHead + that->_nbSeg;
+  // Add the segment to the set of segment
+  GSetAppend(&(that->_seg), seg);
+  // Reset the new control points and add them to the set of control 
+  // points
+  for (int iCtrl = 1; iCtrl <= that->_order; ++iCtrl) {
+    VecSetNull(seg->_ctrl[iCtrl]);
+    GSetAppend(&(that->_ctrl), seg->_ctrl[iCtrl]);
+  }
+  // Update the number of segment
+  ++(that->_nbSeg);
+  // Invalidate the cached data
+  _SCurveInvalidateCache(that);
+}
+
+// Add one segment at the head of the curve (controls are set to 
+// vectors null, except the last one which the first one of the current
+// first segment)
+// The segments and control points may be moved in memory, which 
+// invalidates the pointers previously obtained with SCurveSeg, 
+// SCurveCtrl, SCurveSegs, SCurveCtrls and the iterators on the 
+// SCurve or its GSets
+void SCurveAddSegHead(SCurve* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Make room for the new segment
+  _SCurveReserve(that, 1, 0);
+  // Get the new segment, its last control point is the current first 
+  // control
+  --(that->_iHead);
+  BCurve* seg = that->_segArr + that->_iHead;
+  // Add the segment to the set of segment
+  GSetPush(&(that->_seg), seg);
+  // Reset the new control points and add them to the set of control 
+  // points
+  for (int iCtrl = that->_order; iCtrl--;) {
+    VecSetNull(seg->_ctrl[iCtrl]);
+    GSetPush(&(that->_ctrl), seg->_ctrl[iCtrl]);
+  }
+  // Update the number of segment
+  ++(that->_nbSeg);
+  // Invalidate the cached data
+  _SCurveInvalidateCache(that);
+}
+
+// Remove the first segment of the curve (which must have more than one
+// segment)
+// The pointers to the removed segment and its control points not 
+// shared with the remaining segments, and the iterators on the 
+// SCurve or its GSets, are invalidated
+void SCurveRemoveHeadSeg(SCurve* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (that->_nbSeg < 2) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'that' has only one segment");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Remove the control points from the set of control points
+  for (int iCtrl = 0; iCtrl < that->_order; ++iCtrl)
+    (void)GSetPop(&(that->_ctrl));
+  // Remove the first segment and free its cached data
+  BCurve* seg = (BCurve*)GSetPop(&(that->_seg));
+  _BCurveInvalidateCache(seg);
+  // Update the number of segment and the first segment
+  --(that->_nbSeg);
+  ++(that->_iHead);
+  // Invalidate the cached data
+  _SCurveInvalidateCache(that);
+}
+
+// Remove the last segment of the curve (which must have more than one
+// segment)
+// The pointers to the removed segment and its control points not 
+// shared with the remaining segments, and the iterators on the 
+// SCurve or its GSets, are invalidated
+void SCurveRemoveTailSeg(SCurve* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (that->_nbSeg < 2) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'that' has only one segment");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Remove the control points from the set of control points
+  for (int iCtrl = 0; iCtrl < that->_order; ++iCtrl)
+    (void)GSetDrop(&(that->_ctrl));
+  // Remove the last segment and free its cached data
+  BCurve* seg = (BCurve*)GSetDrop(&(that->_seg));
+  _BCurveInvalidateCache(seg);
+  // Update the number of segment
+  --(that->_nbSeg);
+  // Invalidate the cached data
+  _SCurveInvalidateCache(that);
+}
+
+// Ensure the arrays of segments and control points of the SCurve 'that'
+// have room for at least 'nbHead' more segments at the head and 
+// 'nbTail' more segments at the tail
+void _SCurveReserve(SCurve* const that, const int nbHead, 
+  const int nbTail) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (nbHead < 0 || nbTail < 0) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, 
+      "'nbHead' or 'nbTail' is invalid (%d>=0, %d>=0)", nbHead, nbTail);
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Get the current room at the head and tail of the arrays
+  int roomHead = that->_iHead;
+  int roomTail = that->_capSeg - that->_iHead - that->_nbSeg;
+  // If there is enough room, nothing to do
+  if (roomHead >= nbHead && roomTail >= nbTail)
+    return;
+  // Grow the lacking side(s) geometrically to keep the cost of 
+  // adding segments amortized constant
+  if (roomHead < nbHead)
+    roomHead = nbHead + that->_nbSeg;
+  if (roomTail < nbTail)
+    roomTail = nbTail + that->_nbSeg;
+  int capSeg = roomHead + that->_nbSeg + roomTail;
+  int capCtrl = capSeg * that->_order + 1;
+  // Allocate the new block of control points, null vectors
+  char* ctrlBlock = PBErrMalloc(BCurveErr, that->_sizeCtrl * capCtrl);
+  memset(ctrlBlock, 0, that->_sizeCtrl * capCtrl);
+  VecFloat** ctrlArr = 
+    PBErrMalloc(BCurveErr, sizeof(VecFloat*) * capCtrl);
+  for (int iCtrl = capCtrl; iCtrl--;) {
+    ctrlArr[iCtrl] = (VecFloat*)(ctrlBlock + that->_sizeCtrl * iCtrl);
+    *((long*)&(ctrlArr[iCtrl]->_dim)) = that->_dim;
+  }
+  // Allocate the new array of segments, the 'iSeg'-th one is a view 
+  // on the control points from 'iSeg * order' to '(iSeg + 1) * order'
+  BCurve* segArr = PBErrMalloc(BCurveErr, sizeof(BCurve) * capSeg);
+  memset(segArr, 0, sizeof(BCurve) * capSeg);
+  for (int iSeg = capSeg; iSeg--;) {
+    *((int*)&(segArr[iSeg]._order)) = that->_order;
+    *((int*)&(segArr[iSeg]._dim)) = that->_dim;
+    segArr[iSeg]._ctrl = ctrlArr + iSeg * that->_order;
+    segArr[iSeg]._packed = true;
+#if BUILDMODE == 0
+    if (_BCurveIsStrided(segArr + iSeg) == false) {
+      BCurveErr->_type = PBErrTypeInvalidData;
+      sprintf(BCurveErr->_msg, "segment %d is not strided", iSeg);
+      PBErrCatch(BCurveErr);
+    }
+#endif
+  }
+  // If there are current segments
+  if (that->_nbSeg > 0) {
+    // Copy the control points and the segments' cached data
+    memcpy(ctrlArr[roomHead * that->_order], 
+      that->_ctrlArr[that->_iHead * that->_order], 
+      that->_sizeCtrl * SCurveGetNbCtrl(that));
+    for (int iSeg = that->_nbSeg; iSeg--;) {
+      BCurve* seg = that->_segArr + that->_iHead + iSeg;
+      segArr[roomHead + iSeg]._usePowerBasis = seg->_usePowerBasis;
+      segArr[roomHead + iSeg]._powerBasis = seg->_powerBasis;
+      segArr[roomHead + iSeg]._bound = seg->_bound;
+      segArr[roomHead + iSeg]._tightBound = seg->_tightBound;
+      segArr[roomHead + iSeg]._center = seg->_center;
+    }
+    // Update the sets of segments and control points
+    GSetIterForward iter = GSetIterForwardCreateStatic(&(that->_seg));
+    int i = roomHead;
+    do {
+      GSetIterSetData(&iter, segArr + (i++));
+    } while (GSetIterStep(&iter));
+    iter = GSetIterForwardCreateStatic(&(that->_ctrl));
+    i = roomHead * that->_order;
+    do {
+      GSetIterSetData(&iter, ctrlArr[i++]);
+    } while (GSetIterStep(&iter));
+  }
+  // Replace the control points and segments
+  free(that->_ctrlBlock);
+  free(that->_ctrlArr);
+  free(that->_segArr);
+  that->_ctrlBlock = ctrlBlock;
+  that->_ctrlArr = ctrlArr;
+  that->_segArr = segArr;
+  that->_capSeg = capSeg;
+  that->_iHead = roomHead;
+}
+
+// Get the length of the SCurve 'that'
+// The length is calculated by Gauss-Legendre quadrature and cached in
+// the arc length table of the SCurve
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
+float SCurveGetLength(const SCurve* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Build the arc length table if necessary
+  if (that->_arcLen == NULL)
+    _SCurveUpdateArcLen(that);
+  // Return the length at the end of the table
+  return that->_arcLen[that->_nbSeg * BCURVE_NBARCLENSUB];
+}
+
+// Get the length of the SCurve 'that' from its start to the 
+// parameter 'u'
+// u is clipped to [0.0, _nbSeg]
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
+float SCurveGetLengthAtParam(const SCurve* const that, const float u) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Build the arc length table if necessary
+  if (that->_arcLen == NULL)
+    _SCurveUpdateArcLen(that);
+  // Clip the parameter
+  float v = MIN(MAX(u, 0.0), SCurveGetMaxU(that));
+  // Get the interval of the table containing the parameter
+  int nbSub = that->_nbSeg * BCURVE_NBARCLENSUB;
+  int iSub = MIN((int)(v * BCURVE_NBARCLENSUB), nbSub - 1);
+  int iSeg = iSub / BCURVE_NBARCLENSUB;
+  float t0 = 
+    (float)(iSub % BCURVE_NBARCLENSUB) / (float)BCURVE_NBARCLENSUB;
+  // Add the length from the start of the interval to the parameter
+  return that->_arcLen[iSub] + 
+    _SCurveGetSubLength(that, iSeg, t0, v - (float)iSeg);
+}
+
+// Get the parameter of the SCurve 'that' at which the length from its 
+// start is 'len'
+// The interval containing 'len' is found by binary search in the arc 
+// length table and the parameter is refined by Newton iterations
+// len is clipped to [0.0, SCurveGetLength(that)]
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
+float SCurveGetParamAtLength(const SCurve* const that, const float len) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Build the arc length table if necessary
+  if (that->_arcLen == NULL)
+    _SCurveUpdateArcLen(that);
+  const float* arcLen = that->_arcLen;
+  int nbSub = that->_nbSeg * BCURVE_NBARCLENSUB;
+  // Clip the length
+  if (len <= 0.0)
+    return 0.0;
+  if (len >= arcLen[nbSub])
+    return SCurveGetMaxU(that);
+  // Search the interval of the table containing the length
+  int iSub = 0;
+  int jSub = nbSub;
+  while (jSub - iSub > 1) {
+    int mSub = (iSub + jSub) / 2;
+    if (arcLen[mSub] <= len)
+      iSub = mSub;
+    else
+      jSub = mSub;
+  }
+  int iSeg = iSub / BCURVE_NBARCLENSUB;
+  float t0 = 
+    (float)(iSub % BCURVE_NBARCLENSUB) / (float)BCURVE_NBARCLENSUB;
+  float t1 = t0 + 1.0 / (float)BCURVE_NBARCLENSUB;
+  float lenSub = arcLen[iSub + 1] - arcLen[iSub];
+  if (lenSub <= 0.0)
+    return (float)iSeg + t0;
+  // Interpolate linearly in the interval
+  float t = t0 + (len - arcLen[iSub]) / lenSub * (t1 - t0);
+  // Refine the parameter with Newton iterations
+  const BCurve* seg = SCurveSeg(that, iSeg);
+  float deriv[that->_dim];
+  for (int iStep = 2; iStep--;) {
+    float err = 
+      arcLen[iSub] + _SCurveGetSubLength(that, iSeg, t0, t) - len;
+    BCurveGetDerivative(seg, t, deriv);
+    float speed = 0.0;
+    for (int iDim = that->_dim; iDim--;)
+      speed += deriv[iDim] * deriv[iDim];
+    speed = sqrt(speed);
+    if (speed < PBMATH_EPSILON)
+      break;
+    t = MIN(MAX(t - err / speed, t0), t1);
+  }
+  // Return the parameter
+  return (float)iSeg + t;
+}
+
+// Build the arc length table of the SCurve 'that'
+void _SCurveUpdateArcLen(const SCurve* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // The cache is not part of the curve's value, cast away the const
+  SCurve* curve = (SCurve*)that;
+  int nbSub = that->_nbSeg * BCURVE_NBARCLENSUB;
+  // Allocate memory for the table if necessary
+  if (curve->_arcLen == NULL)
+    curve->_arcLen = PBErrMalloc(BCurveErr, sizeof(float) * (nbSub + 1));
+  // Accumulate the length of each interval
+  curve->_arcLen[0] = 0.0;
+  for (int iSub = 0; iSub < nbSub; ++iSub) {
+    float t0 = 
+      (float)(iSub % BCURVE_NBARCLENSUB) / (float)BCURVE_NBARCLENSUB;
+    float t1 = t0 + 1.0 / (float)BCURVE_NBARCLENSUB;
+    curve->_arcLen[iSub + 1] = curve->_arcLen[iSub] + 
+      _SCurveGetSubLength(that, iSub / BCURVE_NBARCLENSUB, t0, t1);
+  }
+}
+
+// Get the length of the 'iSeg'-th segment of the SCurve 'that' between
+// its local parameters 't0' and 't1' by Gauss-Legendre quadrature
+float _SCurveGetSubLength(const SCurve* const that, const int iSeg, 
+  const float t0, const float t1) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (iSeg < 0 || iSeg >= that->_nbSeg) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'iSeg' is invalid (0<=%d<%d)", 
+      iSeg, that->_nbSeg);
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Nodes and weights of the 5 points Gauss-Legendre quadrature
+  const double node[5] = {0.0, -0.5384693101056831, 0.5384693101056831,
+    -0.9061798459386640, 0.9061798459386640};
+  const double weight[5] = {0.5688888888888889, 0.4786286704993665, 
+    0.4786286704993665, 0.2369268850561891, 0.2369268850561891};
+  const BCurve* seg = SCurveSeg(that, iSeg);
+  float deriv[that->_dim];
+  double mid = 0.5 * ((double)t0 + (double)t1);
+  double half = 0.5 * ((double)t1 - (double)t0);
+  // Sum the weighted speed at each node
+  double len = 0.0;
+  for (int iNode = 5; iNode--;) {
+    BCurveGetDerivative(seg, (float)(mid + half * node[iNode]), deriv);
+    double speed = 0.0;
+    for (int iDim = that->_dim; iDim--;)
+      speed += deriv[iDim] * deriv[iDim];
+    len += weight[iNode] * sqrt(speed);
+  }
+  // Return the length
+  return (float)(len * half);
+}
+
+// Get the bounding box of the SCurve.
+// Return a Facoid whose axis are aligned on the standard coordinate 
+// system.
+// cf SCurveGetTightBoundingBox for the bounding box of the curve 
+// instead of its control points
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer (cf 
+// SCurveGetBound)
+Facoid* SCurveGetBoundingBox(const SCurve* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Get the bounding box of the control points from the cache
+  float bound[2 * that->_dim];
+  SCurveGetBound(that, false, bound);
+  return _BCurveBoundToFacoid(bound, that->_dim);
+}
+
+// Get the tight bounding box of the SCurve, calculated from the 
+// extrema of the curve instead of its control points
+// Return a Facoid whose axis are aligned on the standard coordinate 
+// system.
+Facoid* SCurveGetTightBoundingBox(const SCurve* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  float bound[2 * that->_dim];
+  SCurveGetBound(that, true, bound);
+  return _BCurveBoundToFacoid(bound, that->_dim);
+}
+
+// Get the bounding box of the SCurve 'that' and store it in the array
+// 'res' allocated by the user with 2 * _dim floats (minimum values 
+// followed by maximum values)
+// If 'tight' is true the bounding box of the curve is calculated, 
+// else the one of its control points
+// No memory allocation occurs
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
+void SCurveGetBound(const SCurve* const that, const bool tight, 
+  float* const res) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  int dim = that->_dim;
+  // If the bounding box is not in the cache
+  float** cache = (float**)(tight ? &(that->_tightBound) : 
+    &(that->_bound));
+  if (*cache == NULL) {
+    *cache = PBErrMalloc(BCurveErr, sizeof(float) * 2 * dim);
+    // Merge the bounding boxes of the segments, which are cached too 
+    // and recalculated only for the modified segments
+    float bound[2 * dim];
+    for (int iSeg = 0; iSeg < that->_nbSeg; ++iSeg) {
+      BCurveGetBound(that->_segArr + that->_iHead + iSeg, tight, 
+        (iSeg == 0 ? *cache : bound));
+      for (int iDim = dim; iDim-- && iSeg > 0;) {
+        (*cache)[iDim] = MIN((*cache)[iDim], bound[iDim]);
+        (*cache)[dim + iDim] = 
+          MAX((*cache)[dim + iDim], bound[dim + iDim]);
+      }
+    }
+  }
+  // Copy the bounding box from the cache
+  memcpy(res, *cache, sizeof(float) * 2 * dim);
+}
+
+// Create a new SCurve from the outline of the Facoid 'shap'
+// The Facoid must be of dimension 2
+// Control points are ordered CCW of the Shapoid
+SCurve* SCurveCreateFromFacoid(const Facoid* const shap) {
+#if BUILDMODE == 0
+  if (shap == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'shap' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (ShapoidGetDim(shap) != 2) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, 
+      "'shap' 's dimension is invalid (%d==2)", 
+      ShapoidGetDim(shap));
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Create the curve
+  int order = 1;
+  int dim = 2;
+  int nbSeg = 4;
+  SCurve* ret = SCurveCreate(order, dim, nbSeg);
+  // Set the coordinates of the control points according to the 
+  // Facoid
+  VecFloat* v = VecClone(ShapoidPos(shap));
+  SCurveSetCtrl(ret, 0, v);
+  SCurveSetCtrl(ret, 4, v);
+  VecOp(v, 1.0, ShapoidAxis(shap, 0), 1.0);
+  SCurveSetCtrl(ret, 1, v);
+  VecOp(v, 1.0, ShapoidAxis(shap, 1), 1.0);
+  SCurveSetCtrl(ret, 2, v);
+  VecOp(v, 1.0, ShapoidAxis(shap, 0), -1.0);
+  SCurveSetCtrl(ret, 3, v);
+  VecFree(&v);
+  // Return the curve
+  return ret;
+}
+
+// Create a new SCurve from the outline of the Pyramidoid 'shap'
+// The Pyramidoid must be of dimension 2
+// Control points are ordered CCW of the Shapoid
+SCurve* SCurveCreateFromPyramidoid(const Pyramidoid* const shap) {
+#if BUILDMODE == 0
+  if (shap == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'shap' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (ShapoidGetDim(shap) != 2) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, 
+      "'shap' 's dimension is invalid (%d==2)", 
+      ShapoidGetDim(shap));
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Create the curve
+  SCurve* ret = SCurveCreate(1, 2, 3);
+  // Set the coordinates of the control points according to the 
+  // Facoid
+  VecFloat* ctrl[2] = {NULL};
+  for (int i = 2; i--;) {
+    ctrl[i] = VecClone(ShapoidPos(shap));
+  }
+  VecOp(ctrl[0], 1.0, ShapoidAxis(shap, 0), 1.0);
+  VecOp(ctrl[1], 1.0, ShapoidAxis(shap, 1), 1.0);
+  SCurveSetCtrl(ret, 0, ShapoidPos(shap));
+  SCurveSetCtrl(ret, 1, ctrl[0]);
+  SCurveSetCtrl(ret, 2, ctrl[1]);
+  SCurveSetCtrl(ret, 3, ShapoidPos(shap));
+  for (int i = 2; i--;)
+    VecFree(ctrl + i);
+  // Return the curve
+  return ret;
+}
+
+// Create a new SCurve from the outline of the Spheroid 'shap'
+// The Spheroid must be of dimension 2
+// Control points are ordered CCW of the Shapoid
+// Calculate an approximation as there is no exact solution
+SCurve* SCurveCreateFromSpheroid(const Spheroid* const shap) {
+#if BUILDMODE == 0
+  if (shap == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'shap' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (ShapoidGetDim(shap) != 2) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, 
+      "'shap' 's dimension is invalid (%d==2)", 
+      ShapoidGetDim(shap));
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Create the curve
+  SCurve* ret = SCurveCreate(3, 2, 4);
+  // Set the control points
+  // The anchors of the curve can be easily calculated from the 
+  // position and axis of the Spheroid
+  int iAxis = 0;
+  float coeff = 0.5;
+  VecFloat* ctrl[13] = {NULL};
+  for (int i = 13; i--;)
+    ctrl[i] = VecFloatCreate(2);
+  for (int i = 0; i < 12; i += 3) {
+    VecCopy(ctrl[i], ShapoidPos(shap));
+    if (i == 6)
+      coeff *= -1.0;
+    VecOp(ctrl[i], 1.0, ShapoidAxis(shap, iAxis), coeff);
+    if (i > 0)
+      VecCopy(ctrl[i - 1], ctrl[i]);
+    if (i < 11)
+      VecCopy(ctrl[i + 1], ctrl[i]);
+    iAxis = (iAxis == 0 ? 1 : 0);
+  }
+  VecCopy(ctrl[12], ctrl[0]);
+  VecCopy(ctrl[11], ctrl[0]);
+  // Calculate the others control points by transforming the 
+  // quadratic approximation of a quarter of the unit circle :
+  // A(1,0), B(1,4(sqrt(2)-1)/3), C(4(sqrt(2)-1)/3,1), D(0,1)
+  // toward the Spheroid
+  float c = 0.276142;
+  VecOp(ctrl[1], 1.0, ShapoidAxis(shap, 1), c);
+  VecOp(ctrl[2], 1.0, ShapoidAxis(shap, 0), c);
+  VecOp(ctrl[4], 1.0, ShapoidAxis(shap, 0), -1.0 * c);
+  VecOp(ctrl[5], 1.0, ShapoidAxis(shap, 1), c);
+  VecOp(ctrl[7], 1.0, ShapoidAxis(shap, 1), -1.0 * c);
+  VecOp(ctrl[8], 1.0, ShapoidAxis(shap, 0), -1.0 * c);
+  VecOp(ctrl[10], 1.0, ShapoidAxis(shap, 0), c);
+  VecOp(ctrl[11], 1.0, ShapoidAxis(shap, 1), -1.0 * c);
+  for (int i = 13; i--;)
+    SCurveSetCtrl(ret, i, ctrl[i]);
+  for (int i = 13; i--;)
+    VecFree(ctrl + i);
+  // Return the curve
+  return ret;
+}
+
+// Create a new SCurve made of 'nbSeg' segments of order 3 approximating
+// the points given in the GSet 'set'
+// The GSet must contains VecFloat of same dimensions
+// The SCurve starts at the first point and ends at the last point of
+// 'set', the other control points are calculated by least squares 
+// with the points parameterized by their relative distance on the 
+// polyline linking them, split uniformly between the segments
+// The cost is linear in the number of points and segments
+// Return NULL if it couldn't create the SCurve
+SCurve* SCurveCreateFromCloudPoint(const GSetVecFloat* const set, 
+  const int nbSeg) {
+#if BUILDMODE == 0
+  if (set == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'set' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (GSetNbElem(set) < 2) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'set' has less than 2 points");
+    PBErrCatch(BCurveErr);
+  }
+  if (nbSeg < 1) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'nbSeg' is invalid (%d>0)", nbSeg);
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Get the points in an array for direct access
+  long nbPoint = GSetNbElem(set);
+  const VecFloat** points = 
+    PBErrMalloc(BCurveErr, sizeof(VecFloat*) * nbPoint);
+  GSetIterForward iter = GSetIterForwardCreateStatic(set);
+  long iPoint = 0;
+  do {
+    points[iPoint++] = GSetIterGet(&iter);
+  } while (GSetIterStep(&iter));
+  // Create the curve and fit its control points
+  SCurve* curve = SCurveCreate(3, VecGetDim(points[0]), nbSeg);
+  bool ret = _BCurveFitCtrl(points, nbPoint, NULL, 3, nbSeg, 
+    curve->_ctrlArr + curve->_iHead * 3);
+  // Free memory
+  free(points);
+  // If we couldn't fit the control points
+  if (ret == false)
+    SCurveFree(&curve);
+  // Return the result
+  return curve;
+}
+
+// Get the distance between the SCurve 'that' and the SCurve 'curve'
+// The distance is defined as the integral of 
+// ||'that'(u(t))-'curve'(v(t))|| where u and v are the relative 
+// positions on the curve over t varying from 0.0 to 1.0
+float SCurveGetDistToCurve(const SCurve* const that, 
+  const SCurve* const curve) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'shap' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (curve == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'shap' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (SCurveGetDim(that) != SCurveGetDim(curve)) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, 
+      "dimensions of 'that' and 'curve' differ (%d==%d)",
+      SCurveGetDim(that), SCurveGetDim(curve));
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Get the distance with the default number of samples
+  return SCurveGetDistToCurveSampled(that, curve, BCURVE_DISTNBSAMPLE, 
+    0.0);
+}
+
+// Get the distance between the SCurve 'that' and the SCurve 'curve'
+// (cf SCurveGetDistToCurve) approximated with 'nbSample' samples of t
+// uniformly distributed over [0.0, 1.0[
+// If 'threshold' is greater than 0.0 the calculation stops as soon as
+// the partial integral exceeds 'threshold', and the partial integral is
+// returned
+// No memory allocation occurs
+float SCurveGetDistToCurveSampled(const SCurve* const that, 
+  const SCurve* const curve, const int nbSample, const float threshold) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (curve == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'curve' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (SCurveGetDim(that) != SCurveGetDim(curve)) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, 
+      "dimensions of 'that' and 'curve' differ (%d==%d)",
+      SCurveGetDim(that), SCurveGetDim(curve));
+    PBErrCatch(BCurveErr);
+  }
+  if (nbSample < 1) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'nbSample' is invalid (%d>0)", nbSample);
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Declare a variable to memorize the result
+  float res = 0.0;
+  // Declare a variable to memorize the step over parameter
+  float dt = 1.0 / (float)nbSample;
+  // Declare the buffers to evaluate both curves by blocks of samples
+  int dim = SCurveGetDim(that);
+  float u[BCURVE_DISTNBBLOCK];
+  float v[BCURVE_DISTNBBLOCK];
+  float uloc[BCURVE_DISTNBBLOCK];
+  float valA[BCURVE_DISTNBBLOCK * dim];
+  float valB[BCURVE_DISTNBBLOCK * dim];
+  float maxUA = SCurveGetMaxU(that);
+  float maxUB = SCurveGetMaxU(curve);
+  // Loop on the blocks of samples
+  for (int iFirst = 0; iFirst < nbSample; iFirst += BCURVE_DISTNBBLOCK) {
+    int nb = MIN(BCURVE_DISTNBBLOCK, nbSample - iFirst);
+    // Calculate the relative parameter for both curves
+    for (int i = nb; i--;) {
+      float t = (float)(iFirst + i) * dt;
+      u[i] = t * maxUA;
+      v[i] = t * maxUB;
+    }
+    // Get the values of both curves at these relative parameters
+    _SCurveGetBatchSorted(that, nb, u, uloc, valA);
+    _SCurveGetBatchSorted(curve, nb, v, uloc, valB);
+    // Add the distances between values to the result
+    res += _SCurveSumDist(valA, valB, nb, dim) * dt;
+    // If the result exceeds the threshold, stop here
+    if (threshold > 0.0 && res > threshold)
+      break;
+  }
+  // Return the result
+  return res;
+}
+
+// Get the descriptor of the SCurve 'that' used to calculate distances 
+// between SCurves, i.e. its values at 'nbSample' relative positions t 
+// uniformly distributed over [0.0, 1.0[ (cf SCurveGetDistToCurve), and
+// store it point by point in the array 'res' allocated by the user 
+// with at least 'nbSample' * _dim floats
+// No memory allocation occurs
+void SCurveGetDistDescriptor(const SCurve* const that, 
+  const int nbSample, float* const res) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (nbSample < 1) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'nbSample' is invalid (%d>0)", nbSample);
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  float dt = 1.0 / (float)nbSample;
+  float maxU = SCurveGetMaxU(that);
+  float u[BCURVE_DISTNBBLOCK];
+  float uloc[BCURVE_DISTNBBLOCK];
+  // Loop on the blocks of samples
+  for (int iFirst = 0; iFirst < nbSample; iFirst += BCURVE_DISTNBBLOCK) {
+    int nb = MIN(BCURVE_DISTNBBLOCK, nbSample - iFirst);
+    for (int i = nb; i--;)
+      u[i] = (float)(iFirst + i) * dt * maxU;
+    _SCurveGetBatchSorted(that, nb, u, uloc, res + iFirst * that->_dim);
+  }
+}
+
+// Get the distance between two SCurves from their descriptors 'descA'
+// and 'descB' of 'nbSample' samples in dimension 'dim' 
+// (cf SCurveGetDistDescriptor)
+float SCurveGetDistDescriptors(const float* const descA, 
+  const float* const descB, const int nbSample, const int dim) {
+#if BUILDMODE == 0
+  if (descA == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'descA' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (descB == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'descB' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Return the integral
+  return _SCurveSumDist(descA, descB, nbSample, dim) / (float)nbSample;
+}
+
+// Get the sum of the distances between the 'nb' points of dimension 
+// 'dim' stored point by point in the arrays 'a' and 'b'
+// The points are processed by blocks of BCURVE_NBLANE, with a loop 
+// specialized for the dimensions 2 and 3, and the distances are 
+// accumulated in BCURVE_NBLANE partial sums
+BCURVE_SIMDDISPATCH
+float _SCurveSumDist(const float* const a, const float* const b, 
+  const long nb, const int dim) {
+#if BUILDMODE == 0
+  if (a == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'a' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (b == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'b' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Loop on the blocks of points
+  BCurveLanes sum = {0};
+  float dist[BCURVE_NBLANE];
+  long nbBlock = nb / BCURVE_NBLANE;
+  for (long iBlock = 0; iBlock < nbBlock; ++iBlock) {
+    const float* pa = a + iBlock * BCURVE_NBLANE * dim;
+    const float* pb = b + iBlock * BCURVE_NBLANE * dim;
+    // Get the squared distances of the block
+    if (dim == 2) {
+      for (int i = 0; i < BCURVE_NBLANE; ++i) {
+        float dx = pa[2 * i] - pb[2 * i];
+        float dy = pa[2 * i + 1] - pb[2 * i + 1];
+        dist[i] = dx * dx + dy * dy;
+      }
+    } else if (dim == 3) {
+      for (int i = 0; i < BCURVE_NBLANE; ++i) {
+        float dx = pa[3 * i] - pb[3 * i];
+        float dy = pa[3 * i + 1] - pb[3 * i + 1];
+        float dz = pa[3 * i + 2] - pb[3 * i + 2];
+        dist[i] = dx * dx + dy * dy + dz * dz;
+      }
+    } else {
+      for (int i = 0; i < BCURVE_NBLANE; ++i) {
+        float d2 = 0.0;
+        for (int iDim = 0; iDim < dim; ++iDim) {
+          float d = pa[i * dim + iDim] - pb[i * dim + iDim];
+          d2 += d * d;
+        }
+        dist[i] = d2;
+      }
+    }
+    // Add the distances to the partial sums
+    for (int i = 0; i < BCURVE_NBLANE; ++i)
+      dist[i] = sqrtf(dist[i]);
+    BCurveLanes d;
+    memcpy(&d, dist, sizeof(BCurveLanes));
+    sum += d;
+  }
+  // Add the remaining points
+  float res = 0.0;
+  for (long i = nbBlock * BCURVE_NBLANE; i < nb; ++i) {
+    float d2 = 0.0;
+    for (int iDim = 0; iDim < dim; ++iDim) {
+      float d = a[i * dim + iDim] - b[i * dim + iDim];
+      d2 += d * d;
+    }
+    res += sqrtf(d2);
+  }
+  // Reduce the partial sums
+  for (int i = 0; i < BCURVE_NBLANE; ++i)
+    res += sum[i];
+  return res;
+}
+
+// Get the distances (cf SCurveGetDistToCurveSampled) between each 
+// of the 'nbA' SCurves 'curvesA' and each of the 'nbB' SCurves 
+// 'curvesB', approximated with 'nbSample' samples, and store them in 
+// the array 'res' allocated by the user with at least 'nbA' * 'nbB' 
+// floats (res[iA * nbB + iB])
+// If 'curvesB' is null, get the distances between each pair of SCurves
+// in 'curvesA' ('nbB' is ignored and 'res' must have at least 
+// 'nbA' * 'nbA' floats), only half of the matrix is computed and 
+// copied by symmetry
+// All the SCurves must have the same dimension
+// Each SCurve is sampled once into a descriptor, then the matrix is 
+// computed by tiles of BCURVE_DISTTILE x BCURVE_DISTTILE distances 
+// distributed over 'nbThread' threads, or as many threads as cores if 
+// 'nbThread' is less than 1
+void SCurveGetDistMatrix(const SCurve* const* const curvesA, 
+  const int nbA, const SCurve* const* const curvesB, const int nbB, 
+  const int nbSample, const int nbThread, float* const res) {
+#if BUILDMODE == 0
+  if (curvesA == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'curvesA' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (nbA < 1 || (curvesB != NULL && nbB < 1)) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'nbA' or 'nbB' is invalid (%d>0, %d>0)", 
+      nbA, nbB);
+    PBErrCatch(BCurveErr);
+  }
+  if (nbSample < 1) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'nbSample' is invalid (%d>0)", nbSample);
+    PBErrCatch(BCurveErr);
+  }
+  for (int iB = (curvesB != NULL ? nbB : 0); iB--;) {
+    if (SCurveGetDim(curvesB[iB]) != SCurveGetDim(curvesA[0])) {
+      BCurveErr->_type = PBErrTypeInvalidArg;
+      sprintf(BCurveErr->_msg, "dimensions of the curves differ");
+      PBErrCatch(BCurveErr);
+    }
+  }
+  for (int iA = nbA; iA--;) {
+    if (SCurveGetDim(curvesA[iA]) != SCurveGetDim(curvesA[0])) {
+      BCurveErr->_type = PBErrTypeInvalidArg;
+      sprintf(BCurveErr->_msg, "dimensions of the curves differ");
+      PBErrCatch(BCurveErr);
+    }
+  }
+#endif
+  // Declare the task shared by the threads
+  SCurveDistMatrixTask task;
+  task._sym = (curvesB == NULL);
+  task._nbA = nbA;
+  task._nbB = (task._sym ? nbA : nbB);
+  task._nbSample = nbSample;
+  task._dim = SCurveGetDim(curvesA[0]);
+  task._res = res;
+  task._nextTile = 0;
+  pthread_mutex_init(&(task._mutex), NULL);
+  // Sample each SCurve once into its descriptor
+  // The SCurves are only read here, by the calling thread, the other 
+  // threads use the descriptors only, hence the caches of the SCurves
+  // are never filled concurrently
+  long size = (long)nbSample * task._dim;
+  float* descA = PBErrMalloc(BCurveErr, 
+    sizeof(float) * size * (nbA + (task._sym ? 0 : nbB)));
+  for (int iA = nbA; iA--;)
+    SCurveGetDistDescriptor(curvesA[iA], nbSample, descA + iA * size);
+  float* descB = descA;
+  if (task._sym == false) {
+    descB = descA + nbA * size;
+    for (int iB = nbB; iB--;)
+      SCurveGetDistDescriptor(curvesB[iB], nbSample, descB + iB * size);
+  }
+  task._descA = descA;
+  task._descB = descB;
+  // Get the number of threads
+  int nb = nbThread;
+  if (nb < 1)
+    nb = MAX(1, (int)sysconf(_SC_NPROCESSORS_ONLN));
+  // Start the threads, the current thread being one of them
+  // If a thread can't be created, the tiles it would have computed 
+  // are left to the threads already running, the current one included
+  pthread_t threads[nb];
+  int nbCreated = 1;
+  while (nbCreated < nb && pthread_create(threads + nbCreated, NULL, 
+    _SCurveGetDistMatrixThread, &task) == 0)
+    ++nbCreated;
+  (void)_SCurveGetDistMatrixThread(&task);
+  // Wait for the created threads to end
+  for (int iThread = 1; iThread < nbCreated; ++iThread)
+    pthread_join(threads[iThread], NULL);
+  // Free memory
+  pthread_mutex_destroy(&(task._mutex));
+  free(descA);
+}
+
+// Function executed by the threads computing a matrix of distances 
+// between SCurves, 'arg' is the SCurveDistMatrixTask shared by the 
+// threads
+void* _SCurveGetDistMatrixThread(void* arg) {
+#if BUILDMODE == 0
+  if (arg == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'arg' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  SCurveDistMatrixTask* task = (SCurveDistMatrixTask*)arg;
+  long size = (long)(task->_nbSample) * task->_dim;
+  long nbTileA = (task->_nbA + BCURVE_DISTTILE - 1) / BCURVE_DISTTILE;
+  long nbTileB = (task->_nbB + BCURVE_DISTTILE - 1) / BCURVE_DISTTILE;
+  // Loop until there is no more tile to compute
+  while (true) {
+    // Get the next tile
+    pthread_mutex_lock(&(task->_mutex));
+    long iTile = (task->_nextTile)++;
+    pthread_mutex_unlock(&(task->_mutex));
+    if (iTile >= nbTileA * nbTileB)
+      break;
+    long iTileA = iTile / nbTileB;
+    long iTileB = iTile % nbTileB;
+    // If the matrix is symmetric, the tiles below the diagonal are 
+    // copied from the ones above
+    if (task->_sym == true && iTileB < iTileA)
+      continue;
+    // Loop on the distances of the tile
+    int lastA = MIN(task->_nbA, (iTileA + 1) * BCURVE_DISTTILE);
+    int lastB = MIN(task->_nbB, (iTileB + 1) * BCURVE_DISTTILE);
+    for (int iA = iTileA * BCURVE_DISTTILE; iA < lastA; ++iA) {
+      int firstB = iTileB * BCURVE_DISTTILE;
+      if (task->_sym == true) {
+        if (firstB <= iA) {
+          task->_res[(long)iA * task->_nbB + iA] = 0.0;
+          firstB = iA + 1;
+        }
+      }
+      for (int iB = firstB; iB < lastB; ++iB) {
+        float dist = SCurveGetDistDescriptors(task->_descA + iA * size,
+          task->_descB + iB * size, task->_nbSample, task->_dim);
+        task->_res[(long)iA * task->_nbB + iB] = dist;
+        if (task->_sym == true)
+          task->_res[(long)iB * task->_nbB + iA] = dist;
+      }
+    }
+  }
+  return NULL;
+}
+
+// Get the values of the SCurve 'that' at the 'nbU' paramaters 'u' and
+// store them point by point in the array 'res' allocated by the user 
+// with at least 'nbU' * _dim floats
+// The values match those of SCurveGet within the float precision, 
+// the order of the operations being different
+// The segments are walked monotonically if 'u' is sorted in 
+// increasing order, else the parameters are first grouped by segment
+// u can extend beyond [0.0, _nbSeg]
+void SCurveGetBatch(const SCurve* const that, const long nbU, 
+  const float* const u, float* const res) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (u == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'u' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (nbU < 0) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'nbU' is invalid (%ld>=0)", nbU);
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  if (nbU == 0)
+    return;
+  int dim = that->_dim;
+  // Check if the parameters are sorted
+  bool sorted = true;
+  for (long iU = 1; iU < nbU && sorted; ++iU)
+    if (u[iU] < u[iU - 1])
+      sorted = false;
+  // Allocate memory for the local parameters
+  float* uloc = PBErrMalloc(BCurveErr, sizeof(float) * nbU);
+  // If the parameters are sorted
+  if (sorted == true) {
+    // Walk the segments monotonically
+    _SCurveGetBatchSorted(that, nbU, u, uloc, res);
+  // Else, the parameters are not sorted
+  } else {
+    // Group the parameters by segment with a counting sort
+    long* first = PBErrMalloc(BCurveErr, 
+      sizeof(long) * (that->_nbSeg + 1));
+    long* perm = PBErrMalloc(BCurveErr, sizeof(long) * nbU);
+    int* segs = PBErrMalloc(BCurveErr, sizeof(int) * nbU);
+    float* ulocSorted = PBErrMalloc(BCurveErr, sizeof(float) * nbU);
+    float* val = PBErrMalloc(BCurveErr, sizeof(float) * nbU * dim);
+    memset(first, 0, sizeof(long) * (that->_nbSeg + 1));
+    for (long iU = 0; iU < nbU; ++iU) {
+      segs[iU] = SCurveGetSegIndex(that, u[iU], uloc + iU);
+      ++(first[segs[iU] + 1]);
+    }
+    for (int iSeg = 0; iSeg < that->_nbSeg; ++iSeg)
+      first[iSeg + 1] += first[iSeg];
+    for (long iU = 0; iU < nbU; ++iU) {
+      long jU = (first[segs[iU]])++;
+      perm[jU] = iU;
+      ulocSorted[jU] = uloc[iU];
+    }
+    // Evaluate each segment at once on its parameters, 'first' now 
+    // contains the end of each group
+    long iFirst = 0;
+    for (int iSeg = 0; iSeg < that->_nbSeg; ++iSeg) {
+      if (first[iSeg] > iFirst)
+        BCurveGetBatch(SCurveSeg(that, iSeg), first[iSeg] - iFirst, 
+          ulocSorted + iFirst, val + iFirst * dim, false);
+      iFirst = first[iSeg];
+    }
+    // Put back the values in the order of the parameters
+    for (long jU = 0; jU < nbU; ++jU)
+      memcpy(res + perm[jU] * dim, val + jU * dim, sizeof(float) * dim);
+    // Free memory
+    free(first);
+    free(perm);
+    free(segs);
+    free(ulocSorted);
+    free(val);
+  }
+  // Free memory
+  free(uloc);
+}
+
+// Get the values of the SCurve 'that' at the 'nbU' paramaters 'u' 
+// sorted in increasing order and store them point by point in the 
+// array 'res' allocated by the user with at least 'nbU' * _dim floats
+// 'uloc' is an array allocated by the user with at least 'nbU' floats
+// used to memorize the parameters local to the segments
+// No memory allocation occurs
+void _SCurveGetBatchSorted(const SCurve* const that, const long nbU, 
+  const float* const u, float* const uloc, float* const res) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (u == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'u' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (uloc == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'uloc' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Loop on the runs of parameters in the same segment
+  long iFirst = 0;
+  while (iFirst < nbU) {
+    // Get the segment of the first parameter of the run
+    int iSeg = SCurveGetSegIndex(that, u[iFirst], uloc + iFirst);
+    // Get the local parameters up to the end of the segment
+    long iEnd = iFirst + 1;
+    if (iSeg == that->_nbSeg - 1) {
+      for (; iEnd < nbU; ++iEnd)
+        uloc[iEnd] = u[iEnd] - (float)iSeg;
+    } else {
+      for (; iEnd < nbU && u[iEnd] < (float)(iSeg + 1); ++iEnd)
+        (void)SCurveGetSegIndex(that, u[iEnd], uloc + iEnd);
+    }
+    // Evaluate the segment at once on the whole run
+    BCurveGetBatch(SCurveSeg(that, iSeg), iEnd - iFirst, 
+      uloc + iFirst, res + iFirst * that->_dim, false);
+    iFirst = iEnd;
+  }
+}
+
+// Get the values of the SCurve 'that' at 'nbPoint' parameters 
+// uniformly distributed over [0.0, _nbSeg] (both included) and store 
+// them point by point in the array 'res' allocated by the user with 
+// at least 'nbPoint' * _dim floats
+// 'nbPoint' must be at least 2
+// The values are calculated by forward differencing on each segment
+// (cf BCurveTessellateStep)
+// No memory allocation occurs
+void SCurveTessellate(const SCurve* const that, const long nbPoint, 
+  float* const res) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (nbPoint < 2) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'nbPoint' is invalid (%ld>=2)", nbPoint);
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Declare a variable to memorize the step between points
+  float step = (float)(that->_nbSeg) / (float)(nbPoint - 1);
+  // Loop on segments
+  GSetIterForward iter = GSetIterForwardCreateStatic(&(that->_seg));
+  long iSeg = 0;
+  do {
+    const BCurve* seg = GSetIterGet(&iter);
+    // Get the index of the first and last points in this segment
+    // Point i is in segment floor(i * _nbSeg / (nbPoint - 1)), and 
+    // the last point is in the last segment
+    long iFirst = 
+      (iSeg * (nbPoint - 1) + that->_nbSeg - 1) / that->_nbSeg;
+    long iLast = 
+      ((iSeg + 1) * (nbPoint - 1) + that->_nbSeg - 1) / that->_nbSeg;
+    if (iSeg == that->_nbSeg - 1)
+      iLast = nbPoint;
+    // Tessellate the segment
+    if (iLast > iFirst) {
+      float u0 = 
+        (float)((double)iFirst * that->_nbSeg / (nbPoint - 1) - iSeg);
+      BCurveTessellateStep(seg, u0, step, iLast - iFirst, 
+        res + iFirst * that->_dim);
+    }
+    ++iSeg;
+  } while (GSetIterStep(&iter));
+}
+
+// Tessellate the SCurve 'that' into a polyline whose distance to the 
+// curve is less than 'tol' (cf BCurveTessellateAdaptive), and store 
+// its points point by point in the array 'res' allocated by the user 
+// with at least 'nbMax' * _dim floats
+// Return the number of points of the polyline, if it's greater than 
+// 'nbMax' only the first 'nbMax' points are stored
+// No memory allocation occurs
+long SCurveTessellateAdaptive(const SCurve* const that, const float tol,
+  float* const res, const long nbMax) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (tol <= 0.0) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'tol' is invalid (%f>0)", tol);
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  int nbCtrl = that->_order + 1;
+  float ctrl[nbCtrl * that->_dim];
+  long nbPoint = 0;
+  // Loop on the segments
+  for (int iSeg = 0; iSeg < that->_nbSeg; ++iSeg) {
+    // Get the control points of the segment in one array
+    const BCurve* seg = SCurveSeg(that, iSeg);
+    for (int iCtrl = nbCtrl; iCtrl--;)
+      for (int iDim = that->_dim; iDim--;)
+        ctrl[iCtrl * that->_dim + iDim] = 
+          VecGet(seg->_ctrl[iCtrl], iDim);
+    // Tessellate the segment, its first point is the last point of the
+    // previous segment
+    nbPoint += _BCurveTessellateAdaptive(ctrl, that->_order, that->_dim,
+      tol, iSeg > 0, (nbPoint < nbMax ? res + nbPoint * that->_dim : NULL),
+      nbMax - nbPoint, NULL, NULL);
+  }
+  // Return the number of points
+  return nbPoint;
+}
+
+// Tessellate the SCurve 'that' as SCurveTessellateAdaptive and give 
+// the points one after the other to the function 'fun' with the user 
+// data 'data'
+// Return the number of points of the polyline
+// No memory allocation occurs
+long SCurveTessellateAdaptiveFun(const SCurve* const that, 
+  const float tol, BCurvePointFun fun, void* const data) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (tol <= 0.0) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'tol' is invalid (%f>0)", tol);
+    PBErrCatch(BCurveErr);
+  }
+  if (fun == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'fun' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  int nbCtrl = that->_order + 1;
+  float ctrl[nbCtrl * that->_dim];
+  long nbPoint = 0;
+  // Loop on the segments
+  for (int iSeg = 0; iSeg < that->_nbSeg; ++iSeg) {
+    // Get the control points of the segment in one array
+    const BCurve* seg = SCurveSeg(that, iSeg);
+    for (int iCtrl = nbCtrl; iCtrl--;)
+      for (int iDim = that->_dim; iDim--;)
+        ctrl[iCtrl * that->_dim + iDim] = 
+          VecGet(seg->_ctrl[iCtrl], iDim);
+    // Tessellate the segment, its first point is the last point of the
+    // previous segment
+    nbPoint += _BCurveTessellateAdaptive(ctrl, that->_order, that->_dim,
+      tol, iSeg > 0, NULL, 0, fun, data);
+  }
+  // Return the number of points
+  return nbPoint;
+}
+
+// Apply the chaikin curve subdivision algorithm to the SCurve 'that'
+// with 'depth' times recursion and 'strength' is the parametric
+// distance from each corner where the curve is cut at each recursion
+// 'strength' in [0.0, 1.0]
+// The SCurve must be of order 1, if it is not nothing happens
+// cf http://graphics.cs.ucdavis.edu/education/CAGDNotes/Chaikins-Algorithm.pdf
+SCurve* SCurveChaikinSubdivision(SCurve* const that, 
+  const float strength, const unsigned int depth) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (strength < 0.0 || strength > 1.0) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'strength' is invalid (0<=%f<=1)", 
+      strength);
+    PBErrCatch(BCurveErr);
+  }
+#endif
+
+  // Init the result with a clone of the original curve
+  SCurve* res = SCurveClone(that);
+
+  // If the SCurve order is 1
+  if (SCurveGetOrder(that) == 1) {
+
+    // Loop on the depth
+    for (unsigned int iDepth = depth; iDepth--;) {
+
+      // If there is only one segment there is no corner to cut
+      int nbSeg = SCurveGetNbSeg(res);
+      if (nbSeg < 2)
+        break;
+
+      // Create the new curve, the first and last segments are cut
+      // once, the other ones twice
+      SCurve* cut = SCurveCreate(
+        SCurveGetOrder(that), SCurveGetDim(that), 2 * nbSeg - 1);
+
+      // Keep the first control point
+      SCurveSetCtrl(cut, 0, SCurveCtrl(res, 0));
+      int iCtrl = 1;
+
+      // Loop on the segments of the curve
+      for (int iSeg = 0; iSeg < nbSeg; ++iSeg) {
+
+        // Get the current segment
+        const BCurve* curSeg = SCurveSeg(res, iSeg);
+
+        // If it's not the first segment, cut its head
+        if (iSeg > 0) {
+          VecFloat* pos = BCurveGet(curSeg, strength);
+          SCurveSetCtrl(cut, iCtrl++, pos);
+          VecFree(&pos);
+        }
+
+        // If it's not the last segment, cut its tail
+        if (iSeg < nbSeg - 1) {
+          VecFloat* pos = BCurveGet(curSeg, 1.0 - strength);
+          SCurveSetCtrl(cut, iCtrl++, pos);
+          VecFree(&pos);
+        }
+      }
+
+      // Keep the last control point
+      SCurveSetCtrl(cut, iCtrl, SCurveCtrl(res, nbSeg));
+
+      // Replace the current result with the new curve
+      SCurveFree(&res);
+      res = cut;
+
+    }
+  }
+
+  // Return the result
+  return res;
+}
+
+// -------------- SCurveIter
+
+// ================ Functions implementation ====================
+
+// Create a new SCurveIter attached to the SCurve 'curve' with a step 
+// of 'delta'
+SCurveIter SCurveIterCreateStatic(const SCurve* const curve, 
+  const float delta) {
+#if BUILDMODE == 0
+  if (curve == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'curve' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (delta <= 0.0) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'delta' is invalid (%f>0)", delta);
+    PBErrCatch(BCurveErr);
+  }
+#endif  
+  // Declare the new SCurveIter
+  SCurveIter iter;
+  // Set the properties
+  iter._curve = curve;
+  iter._curPos = 0.0;
+  iter._delta = delta;
+  iter._iSeg = 0;
+  iter._uloc = 0.0;
+  iter._byLength = false;
+  iter._curLen = 0.0;
+  // Return the new iterator
+  return iter;
+}
+
+// -------------- SCurveBVH
+
+// ================ Functions implementation ====================
+
+// Create a new SCurveBVH over the segments of the SCurve 'curve'
+SCurveBVH* SCurveBVHCreate(const SCurve* const curve) {
+#if BUILDMODE == 0
+  if (curve == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'curve' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Allocate memory
+  SCurveBVH* that = PBErrMalloc(BCurveErr, sizeof(SCurveBVH));
+  // Set the properties
+  that->_curve = curve;
+  that->_dim = SCurveGetDim(curve);
+  that->_nbSeg = 0;
+  that->_nbNode = 0;
+  that->_bound = NULL;
+  that->_segBound = NULL;
+  // Allocate the nodes and calculate the bounding boxes
+  SCurveBVHRefit(that);
+  // Return the new SCurveBVH
+  return that;
+}
+
+// Free the memory used by the SCurveBVH 'that'
+void SCurveBVHFree(SCurveBVH** that) {
+  // Check argument
+  if (that == NULL || *that == NULL)
+    return;
+  // Free memory
+  free((*that)->_bound);
+  free((*that)->_segBound);
+  free(*that);
+  *that = NULL;
+}
+
+// Get the number of nodes needed to cover the segments 'first' to 
+// 'last' (excluded) with the node 'iNode' and its descendants
+int _SCurveBVHGetNbNode(const int iNode, const int first, 
+  const int last) {
+  // If the node is a leaf
+  if (last - first <= BCURVE_BVHLEAFSIZE)
+    return iNode + 1;
+  // Get the number of nodes needed by the two children
+  int mid = (first + last) / 2;
+  int nbLeft = _SCurveBVHGetNbNode(2 * iNode + 1, first, mid);
+  int nbRight = _SCurveBVHGetNbNode(2 * iNode + 2, mid, last);
+  // Return the result
+  return MAX(nbLeft, nbRight);
+}
+
+// Update the bounding box of the node 'iNode' covering the segments 
+// 'first' to 'last' (excluded) of the SCurveBVH 'that' and of its 
+// descendants
+void _SCurveBVHRefitNode(SCurveBVH* const that, const int iNode, 
+  const int first, const int last) {
+  int dim = that->_dim;
+  float* bound = that->_bound + 2 * dim * iNode;
+  // If the node is a leaf
+  if (last - first <= BCURVE_BVHLEAFSIZE) {
+    // Merge the bounding boxes of its segments
+    memcpy(bound, that->_segBound + 2 * dim * first, 
+      sizeof(float) * 2 * dim);
+    for (int iSeg = first + 1; iSeg < last; ++iSeg) {
+      const float* segBound = that->_segBound + 2 * dim * iSeg;
+      for (int i = dim; i--;) {
+        bound[i] = MIN(bound[i], segBound[i]);
+        bound[dim + i] = MAX(bound[dim + i], segBound[dim + i]);
+      }
+    }
+  // Else, the node has two children
+  } else {
+    // Update the children and merge their bounding boxes
+    int mid = (first + last) / 2;
+    _SCurveBVHRefitNode(that, 2 * iNode + 1, first, mid);
+    _SCurveBVHRefitNode(that, 2 * iNode + 2, mid, last);
+    const float* left = that->_bound + 2 * dim * (2 * iNode + 1);
+    const float* right = that->_bound + 2 * dim * (2 * iNode + 2);
+    for (int i = dim; i--;) {
+      bound[i] = MIN(left[i], right[i]);
+      bound[dim + i] = MAX(left[dim + i], right[dim + i]);
+    }
   }
 }
 
-// Function which return the JSON encoding of 'that' 
-JSONNode* SCurveEncodeAsJSON(const SCurve* const that) {
+// Update the bounding boxes of the SCurveBVH 'that' after its 
+// attached SCurve has been modified, in O(number of segments)
+// If the number of segments of the SCurve has changed the nodes are
+// reallocated
+void SCurveBVHRefit(SCurveBVH* const that) {
 #if BUILDMODE == 0
   if (that == NULL) {
-    PBMathErr->_type = PBErrTypeNullPointer;
-    sprintf(PBMathErr->_msg, "'that' is null");
-    PBErrCatch(PBMathErr);
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
   }
 #endif
-  // Create the JSON structure
-  JSONNode* json = JSONCreate();
-  // Declare a buffer to convert value into string
-  char val[100];
-  // Encode the order
-  sprintf(val, "%d", SCurveGetOrder(that));
-  JSONAddProp(json, "_order", val);
-  // Encode the dimension
-  sprintf(val, "%d", SCurveGetDim(that));
-  JSONAddProp(json, "_dim", val);
-  // Encode the nb of segment
-  sprintf(val, "%d", SCurveGetNbSeg(that));
-  JSONAddProp(json, "_nbSeg", val);
-  // Encode the control points
-  JSONArrayStruct setCtrl = JSONArrayStructCreateStatic();
-  GSetIterForward iter = GSetIterForwardCreateStatic(&(that->_ctrl));
-  do {
-    VecFloat* ctrl = (VecFloat*)GSetIterGet(&iter);
-    JSONArrayStructAdd(&setCtrl, VecEncodeAsJSON(ctrl));
-  } while (GSetIterStep(&iter));
-  JSONAddProp(json, "_ctrl", &setCtrl);
-  // Free memory
-  JSONArrayStructFlush(&setCtrl);
-  // Return the created JSON 
-  return json;
+  const SCurve* curve = that->_curve;
+  int dim = that->_dim;
+  // If the number of segments has changed, reallocate the nodes
+  if (that->_nbSeg != SCurveGetNbSeg(curve)) {
+    that->_nbSeg = SCurveGetNbSeg(curve);
+    that->_nbNode = _SCurveBVHGetNbNode(0, 0, that->_nbSeg);
+    free(that->_bound);
+    free(that->_segBound);
+    that->_bound = 
+      PBErrMalloc(BCurveErr, sizeof(float) * 2 * dim * that->_nbNode);
+    that->_segBound = 
+      PBErrMalloc(BCurveErr, sizeof(float) * 2 * dim * that->_nbSeg);
+  }
+  // Update the tight bounding boxes of the segments, cached in the 
+  // segments and recalculated only for the modified ones
+  for (int iSeg = 0; iSeg < that->_nbSeg; ++iSeg)
+    BCurveGetBound(curve->_segArr + curve->_iHead + iSeg, true, 
+      that->_segBound + 2 * dim * iSeg);
+  // Update the bounding boxes of the nodes
+  _SCurveBVHRefitNode(that, 0, 0, that->_nbSeg);
 }
 
-// Function which decode from JSON encoding 'json' to 'that'
-bool SCurveDecodeAsJSON(SCurve** that, const JSONNode* const json) {
+// Get the SCurveBVH attached to the SCurve 'that', build it or refit 
+// it if necessary
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
+const SCurveBVH* SCurveGetBVH(const SCurve* const that) {
 #if BUILDMODE == 0
   if (that == NULL) {
-    PBMathErr->_type = PBErrTypeNullPointer;
-    sprintf(PBMathErr->_msg, "'that' is null");
-    PBErrCatch(PBMathErr);
-  }
-  if (json == NULL) {
-    PBMathErr->_type = PBErrTypeNullPointer;
-    sprintf(PBMathErr->_msg, "'json' is null");
-    PBErrCatch(PBMathErr);
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
   }
 #endif
-  // If 'that' is already allocated
-  if (*that != NULL)
-    // Free memory
-    SCurveFree(that);
-  // Get the order from the JSON
-  JSONNode* prop = JSONProperty(json, "_order");
-  if (prop == NULL) {
-    return false;
-  }
-  int order = atoi(JSONLblVal(prop));
-  // Get the dimension from the JSON
-  prop = JSONProperty(json, "_dim");
-  if (prop == NULL) {
-    return false;
-  }
-  int dim = atoi(JSONLblVal(prop));
-  // Get the nb of segment from the JSON
-  prop = JSONProperty(json, "_nbSeg");
-  if (prop == NULL) {
-    return false;
-  }
-  int nbSeg = atoi(JSONLblVal(prop));
-  // If data are invalid
-  if (nbSeg < 1 || order < 0 || dim < 1)
-    return false;
-  // Allocate memory
-  *that = SCurveCreate(order, dim, nbSeg);
-  // Decode the control points
-  prop = JSONProperty(json, "_ctrl");
-  if (prop == NULL) {
-    return false;
-  }
-  if (JSONGetNbValue(prop) != SCurveGetNbCtrl(*that)) {
-    return false;
-  }
-  GSetIterForward iter = GSetIterForwardCreateStatic(&((*that)->_ctrl));
-  int iCtrl = 0;
-  do {
-    VecFloat* loadCtrl = NULL;
-    JSONNode* ctrl = JSONValue(prop, iCtrl);
-    if (!VecDecodeAsJSON(&loadCtrl, ctrl) || 
-      VecGetDim(loadCtrl) != dim) {
-      return false;
+  // The SCurveBVH is a cache, update it through a non const pointer
+  SCurve* curve = (SCurve*)that;
+  if (curve->_bvh == NULL)
+    curve->_bvh = SCurveBVHCreate(that);
+  else if (curve->_bvhDirty)
+    SCurveBVHRefit(curve->_bvh);
+  curve->_bvhDirty = false;
+  // Return the SCurveBVH
+  return curve->_bvh;
+}
+
+// Get the indices of the segments of the SCurveBVH 'that' whose 
+// bounding box satisfies the query of type 'type' (0: box, 1: ray, 
+// 2: point) with arguments 'a', 'b' and 'r'
+long _SCurveBVHQuery(const SCurveBVH* const that, const int type,
+  const float* const a, const float* const b, const float r,
+  int* const res, const long nbMax) {
+  int dim = that->_dim;
+  long nb = 0;
+  // Stack of the nodes to visit with the range of their segments
+  int stack[BCURVE_BVHSTACK][3];
+  int nbStack = 1;
+  stack[0][0] = 0;
+  stack[0][1] = 0;
+  stack[0][2] = that->_nbSeg;
+  // Loop until there is no more node to visit
+  while (nbStack > 0) {
+    --nbStack;
+    int iNode = stack[nbStack][0];
+    int first = stack[nbStack][1];
+    int last = stack[nbStack][2];
+    // If the query doesn't match the node, skip its segments
+    if (!_SCurveBVHMatch(that->_bound + 2 * dim * iNode, dim, type, 
+      a, b, r))
+      continue;
+    // If the node is a leaf
+    if (last - first <= BCURVE_BVHLEAFSIZE) {
+      // Add the matching segments to the result
+      for (int iSeg = first; iSeg < last; ++iSeg) {
+        if (_SCurveBVHMatch(that->_segBound + 2 * dim * iSeg, dim, 
+          type, a, b, r)) {
+          if (nb < nbMax)
+            res[nb] = iSeg;
+          ++nb;
+        }
+      }
+    // Else, visit its children, the left one first to keep the 
+    // segments in increasing order
+    } else {
+      int mid = (first + last) / 2;
+      stack[nbStack][0] = 2 * iNode + 2;
+      stack[nbStack][1] = mid;
+      stack[nbStack][2] = last;
+      stack[nbStack + 1][0] = 2 * iNode + 1;
+      stack[nbStack + 1][1] = first;
+      stack[nbStack + 1][2] = mid;
+      nbStack += 2;
     }
-    // Set the loaded control point into the set of control point
-    // and segment
-    VecCopy((VecFloat*)GSetIterGet(&iter), loadCtrl);
-    // Free memory used by the loaded control
-    VecFree(&loadCtrl);
-    ++iCtrl;
-  } while (GSetIterStep(&iter));
-  // Return the success code
-  return true;
+  }
+  // Return the number of segments found
+  return nb;
 }
 
-// Load the SCurve from the stream
-// If the SCurve is already allocated, it is freed before loading
-// Return true in case of success, false else
-bool SCurveLoad(SCurve** that, FILE* const stream) {
+// Get the indices of the segments of the SCurveBVH 'that' whose 
+// bounding box intersects the box 'boxMin' 'boxMax'
+// Store in increasing order at most 'nbMax' indices in the array 
+// 'res' allocated by the user, and return the total number of 
+// segments found
+long SCurveBVHQueryBox(const SCurveBVH* const that, 
+  const float* const boxMin, const float* const boxMax, 
+  int* const res, const long nbMax) {
 #if BUILDMODE == 0
   if (that == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
     sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
-  if (stream == NULL) {
+  if (boxMin == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
-    sprintf(BCurveErr->_msg, "'stream' is null");
+    sprintf(BCurveErr->_msg, "'boxMin' is null");
     PBErrCatch(BCurveErr);
   }
-#endif
-  // Declare a json to load the encoded data
-  JSONNode* json = JSONCreate();
-  // Load the whole encoded data
-  if (!JSONLoad(json, stream)) {
-    return false;
+  if (boxMax == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'boxMax' is null");
+    PBErrCatch(BCurveErr);
   }
-  // Decode the data from the JSON
-  if (!SCurveDecodeAsJSON(that, json)) {
-    return false;
+  if (res == NULL && nbMax > 0) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
   }
-  // Free the memory used by the JSON
-  JSONFree(&json);
-  // Return the success code
-  return true;
+#endif
+  return _SCurveBVHQuery(that, 0, boxMin, boxMax, 0.0, res, nbMax);
 }
 
-// Save the SCurve to the stream
-// If 'compact' equals true it saves in compact form, else it saves in 
-// readable form
-// Return true upon success, false else
-bool SCurveSave(const SCurve* const that, FILE* const stream, 
-  const bool compact) {
+// Get the indices of the segments of the SCurveBVH 'that' whose 
+// bounding box is intersected by the ray 'origin' + t * 'dir', 
+// t in [0, 'tMax']
+// Store in increasing order at most 'nbMax' indices in the array 
+// 'res' allocated by the user, and return the total number of 
+// segments found
+long SCurveBVHQueryRay(const SCurveBVH* const that, 
+  const float* const origin, const float* const dir, const float tMax,
+  int* const res, const long nbMax) {
 #if BUILDMODE == 0
   if (that == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
     sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
-  if (stream == NULL) {
+  if (origin == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
-    sprintf(BCurveErr->_msg, "'stream' is null");
+    sprintf(BCurveErr->_msg, "'origin' is null");
     PBErrCatch(BCurveErr);
   }
-#endif
-  // Get the JSON encoding
-  JSONNode* json = SCurveEncodeAsJSON(that);
-  // Save the JSON
-  if (!JSONSave(json, stream, compact)) {
-    return false;
+  if (dir == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'dir' is null");
+    PBErrCatch(BCurveErr);
   }
-  // Free memory
-  JSONFree(&json);
-  // Return success code
-  return true;
-}
-
-// Free the memory used by a SCurve
-void SCurveFree(SCurve** that) {
-  // Check argument
-  if (that == NULL || *that == NULL)
-    return;
-  // For each control point
-  GSetIterForward iter = GSetIterForwardCreateStatic(&((*that)->_ctrl));
-  do {
-    VecFloat* ctrl = (VecFloat*)GSetIterGet(&iter);
-    // Free the memory used by the control point
-    VecFree(&ctrl);
-  } while (GSetIterStep(&iter));
-  // Free the memory used by the set of control point
-  GSetFlush(&((*that)->_ctrl));
-  // For each segment
-  iter = GSetIterForwardCreateStatic(&((*that)->_seg));
-  do {
-    BCurve* seg = (BCurve*)GSetIterGet(&iter);
-    // Disconnect the control points which have been already freed
-    // or doesn't need to be freed (the last one)
-    for (int iCtrl = 0; iCtrl <= (*that)->_order; ++iCtrl)
-      seg->_ctrl[iCtrl] = NULL;
-    // Free the meory used by the segment
-    BCurveFree(&seg);
-  } while (GSetIterStep(&iter));
-  // Free the memory used by the set of segment
-  GSetFlush(&((*that)->_seg));
-  // Free memory
-  free(*that);
-  *that = NULL;
+  if (res == NULL && nbMax > 0) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  return _SCurveBVHQuery(that, 1, origin, dir, tMax, res, nbMax);
 }
 
-// Print the SCurve on 'stream'
-void SCurvePrint(const SCurve* const that, FILE* const stream) {
+// Get the indices of the segments of the SCurveBVH 'that' whose 
+// bounding box is at a distance less or equal than 'radius' 
+// from the point 'center'
+// Store in increasing order at most 'nbMax' indices in the array 
+// 'res' allocated by the user, and return the total number of 
+// segments found
+long SCurveBVHQueryPoint(const SCurveBVH* const that, 
+  const float* const center, const float radius, 
+  int* const res, const long nbMax) {
 #if BUILDMODE == 0
   if (that == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
     sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
-  if (stream == NULL) {
+  if (center == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
-    sprintf(BCurveErr->_msg, "'stream' is null");
+    sprintf(BCurveErr->_msg, "'center' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL && nbMax > 0) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
     PBErrCatch(BCurveErr);
   }
 #endif
-  // Print the order and dim
-  fprintf(stream, "order(%d) dim(%d) nbSeg(%d) ", 
-    that->_order, that->_dim, that->_nbSeg);
-  // For each control point
-  GSetIterForward iter = GSetIterForwardCreateStatic(&(that->_ctrl));
-  int iMark = 0;
-  do {
-    VecFloat* ctrl = (VecFloat*)GSetIterGet(&iter);
-    if (iMark == 0)
-      fprintf(stream, "<");
-    //VecPrint(ctrl, stream);
-    VecFloatPrint(ctrl, stream, 6);
-    if (iMark == 0)
-      fprintf(stream, ">");
-    if (GSetIterIsLast(&iter) == false) 
-      fprintf(stream, " ");
-    ++iMark;
-    if (iMark == that->_order)
-      iMark = 0;
-  } while (GSetIterStep(&iter));
+  return _SCurveBVHQuery(that, 2, center, NULL, radius, res, nbMax);
 }
 
-// Add one segment at the end of the curve (controls are set to 
-// vectors null, except the first one which the last one of the current
-// last segment)
-void SCurveAddSegTail(SCurve* const that) {
+// Get the parameter 't' in [0,1] of the closest point to 'point' on 
+// the segment 'iSeg' of the SCurve 'that' by Newton iterations 
+// seeded from the value of 't' if 'sampleW' is null, else from the 
+// closest of the (BCURVE_CLOSESTNBSAMPLE + 1) samples whose Bernstein
+// weights are given in 'sampleW'
+// Return the square of the distance to the closest point
+float _SCurveGetClosestSeg(const SCurve* const that, const int iSeg,
+  const float* const point, const float* const sampleW, 
+  float* const t) {
+  int order = that->_order;
+  int dim = that->_dim;
+  VecFloat* const* ctrl = 
+    that->_ctrlArr + (that->_iHead + iSeg) * order;
+  float val[dim];
+  float d1[dim];
+  float d2[dim];
+  // Declare variables to memorize the best parameter and distance
+  float bestT = *t;
+  float best = -1.0;
+  // If the search is not seeded, seed it with the closest sample
+  if (sampleW != NULL) {
+    for (int iSample = 0; iSample <= BCURVE_CLOSESTNBSAMPLE; 
+      ++iSample) {
+      const float* w = sampleW + iSample * (order + 1);
+      float dist = 0.0;
+      for (int i = dim; i--;) {
+        float v = -point[i];
+        for (int k = order + 1; k--;)
+          v += w[k] * ctrl[k]->_val[i];
+        dist += v * v;
+      }
+      if (best < 0.0 || dist < best) {
+        best = dist;
+        bestT = (float)iSample / (float)BCURVE_CLOSESTNBSAMPLE;
+      }
+    }
+  }
+  // Newton iterations on the derivative of the square of the 
+  // distance, (val - point) . d1
+  float s = bestT;
+  for (int iter = BCURVE_CLOSESTNBITER; iter--;) {
+    _BCurveGetValDeriv(ctrl, order, dim, s, val, d1, d2);
+    float f = 0.0;
+    float df = 0.0;
+    float dist = 0.0;
+    for (int i = dim; i--;) {
+      float diff = val[i] - point[i];
+      f += diff * d1[i];
+      df += d1[i] * d1[i] + diff * d2[i];
+      dist += diff * diff;
+    }
+    if (best < 0.0 || dist < best) {
+      best = dist;
+      bestT = s;
+    }
+    // Stop if the distance is not convex here or if the step becomes 
+    // negligible
+    if (df <= PBMATH_EPSILON)
+      break;
+    float next = MIN(1.0, MAX(0.0, s - f / df));
+    if (fabs(next - s) < PBMATH_EPSILON)
+      break;
+    s = next;
+  }
+  // Return the result
+  *t = bestT;
+  return best;
+}
+
+// Get the parameters of the closest points on the SCurve 'that' of 
+// the 'nbPoint' points 'points' (stored one after the other)
+// The SCurveBVH of 'that' is used to skip the segments which can't 
+// contain the closest point, then on each remaining segment the 
+// parameter is refined by Newton iterations seeded from a coarse 
+// sample
+// If 'warmStart' is true, the search for the 'iPoint'-th point starts
+// from the closest point of the previous one (from the value of 
+// u[0] for the first one, clamped to [0, SCurveGetMaxU], the search 
+// being cold if it's not a finite number), which speeds up the 
+// projection of sequences of close points
+// Store the parameters in the array 'u' and, if 'dist' is not null, 
+// the distances to the SCurve in the array 'dist', both allocated by 
+// the user with at least 'nbPoint' floats
+// No memory allocation occurs, except when the SCurveBVH has to be 
+// built
+// Not thread-safe: it may build the bounding volume hierarchy of 
+// the SCurve(s) (cf SCurveGetBVH)
+void SCurveGetClosestBatch(const SCurve* const that, 
+  const long nbPoint, const float* const points, const bool warmStart,
+  float* const u, float* const dist) {
 #if BUILDMODE == 0
   if (that == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
     sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
+  if (points == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'points' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (u == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'u' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (nbPoint < 0) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'nbPoint' is invalid (%ld>=0)", nbPoint);
+    PBErrCatch(BCurveErr);
+  }
 #endif
-  // Create the new segment
-  BCurve* seg = BCurveCreate(that->_order, that->_dim);
-  // Free memory used by the first control point
-  VecFree(seg->_ctrl);
-  // Replace it with the current last control
-  seg->_ctrl[0] = GSetTail(&(that->_ctrl));
-  // Add the segment to the set of segment
-  GSetAppend(&(that->_seg), seg);
-  // Add the new control points to the set of control points
-  for (int iCtrl = 1; iCtrl <= that->_order; ++iCtrl)
-    GSetAppend(&(that->_ctrl), seg->_ctrl[iCtrl]);
-  // Update the number of segment
-  ++(that->_nbSeg);
+  const SCurveBVH* bvh = SCurveGetBVH(that);
+  int dim = that->_dim;
+  int order = that->_order;
+  const float* start = that->_ctrlArr[that->_iHead * order]->_val;
+  // Bernstein weights of the samples seeding the Newton iterations
+  float sampleW[(BCURVE_CLOSESTNBSAMPLE + 1) * (order + 1)];
+  for (int iSample = 0; iSample <= BCURVE_CLOSESTNBSAMPLE; ++iSample) {
+    float s = (float)iSample / (float)BCURVE_CLOSESTNBSAMPLE;
+    float* w = sampleW + iSample * (order + 1);
+    float binom = 1.0;
+    for (int k = 0; k <= order; ++k) {
+      w[k] = binom * pow(s, k) * pow(1.0 - s, order - k);
+      binom = binom * (float)(order - k) / (float)(k + 1);
+    }
+  }
+  // Stack of the nodes to visit with the range of their segments and 
+  // the square of the distance to their bounding box
+  int stack[BCURVE_BVHSTACK][3];
+  float stackDist[BCURVE_BVHSTACK];
+  // Loop on points
+  for (long iPoint = 0; iPoint < nbPoint; ++iPoint) {
+    const float* point = points + iPoint * dim;
+    // Initialize the closest point with the start of the SCurve
+    float bestU = 0.0;
+    float best = 0.0;
+    for (int i = dim; i--;)
+      best += (start[i] - point[i]) * (start[i] - point[i]);
+    // If the search is warm started, refine the closest point of the 
+    // previous point to get a tighter bound, unless the previous 
+    // parameter is not a number in which case the search is cold
+    float prev = (iPoint == 0 ? u[0] : u[iPoint - 1]);
+    if (warmStart && isfinite(prev)) {
+      float t = 0.0;
+      prev = MIN(SCurveGetMaxU(that), MAX(0.0, prev));
+      int iSeg = SCurveGetSegIndex(that, prev, &t);
+      t = MIN(1.0, MAX(0.0, t));
+      float d = _SCurveGetClosestSeg(that, iSeg, point, NULL, &t);
+      if (d < best) {
+        best = d;
+        bestU = (float)iSeg + t;
+      }
+    }
+    // Search the SCurveBVH, nearest nodes first, skipping the nodes 
+    // farther than the current closest point
+    int nbStack = 1;
+    stack[0][0] = 0;
+    stack[0][1] = 0;
+    stack[0][2] = bvh->_nbSeg;
+    stackDist[0] = _SCurveBVHGetDist2(bvh->_bound, dim, point);
+    while (nbStack > 0) {
+      --nbStack;
+      if (stackDist[nbStack] >= best)
+        continue;
+      int iNode = stack[nbStack][0];
+      int first = stack[nbStack][1];
+      int last = stack[nbStack][2];
+      // If the node is a leaf
+      if (last - first <= BCURVE_BVHLEAFSIZE) {
+        // Search the segments close enough
+        for (int iSeg = first; iSeg < last; ++iSeg) {
+          if (_SCurveBVHGetDist2(bvh->_segBound + 2 * dim * iSeg, dim,
+            point) < best) {
+            float t = 0.0;
+            float d = 
+              _SCurveGetClosestSeg(that, iSeg, point, sampleW, &t);
+            if (d < best) {
+              best = d;
+              bestU = (float)iSeg + t;
+            }
+          }
+        }
+      // Else, push the children, the nearest one last to visit it 
+      // first
+      } else {
+        int mid = (first + last) / 2;
+        int iLeft = 2 * iNode + 1;
+        int iRight = 2 * iNode + 2;
+        float dLeft = 
+          _SCurveBVHGetDist2(bvh->_bound + 2 * dim * iLeft, dim, point);
+        float dRight = 
+          _SCurveBVHGetDist2(bvh->_bound + 2 * dim * iRight, dim, 
+          point);
+        bool leftFirst = (dLeft <= dRight);
+        stack[nbStack][0] = (leftFirst ? iRight : iLeft);
+        stack[nbStack][1] = (leftFirst ? mid : first);
+        stack[nbStack][2] = (leftFirst ? last : mid);
+        stackDist[nbStack] = (leftFirst ? dRight : dLeft);
+        stack[nbStack + 1][0] = (leftFirst ? iLeft : iRight);
+        stack[nbStack + 1][1] = (leftFirst ? first : mid);
+        stack[nbStack + 1][2] = (leftFirst ? mid : last);
+        stackDist[nbStack + 1] = (leftFirst ? dLeft : dRight);
+        nbStack += 2;
+      }
+    }
+    // Memorize the result
+    u[iPoint] = bestU;
+    if (dist != NULL)
+      dist[iPoint] = sqrt(best);
+  }
+}
+
+// Split the Bezier curve of order 'order' and dimension 'dim' with 
+// control points 'ctrl' (stored one after the other) at its middle 
+// and store the control points of the two halves in 'left' and 
+// 'right'
+void _BCurveSplitCtrl(const float* const ctrl, const int order, 
+  const int dim, float* const left, float* const right) {
+  // Apply the De Casteljau algorithm, the first and last points of 
+  // each level are the control points of the halves
+  float tmp[(order + 1) * dim];
+  memcpy(tmp, ctrl, sizeof(float) * (order + 1) * dim);
+  for (int level = 0; level <= order; ++level) {
+    memcpy(left + level * dim, tmp, sizeof(float) * dim);
+    memcpy(right + (order - level) * dim, tmp + (order - level) * dim,
+      sizeof(float) * dim);
+    for (int k = 0; k < order - level; ++k)
+      for (int i = dim; i--;)
+        tmp[k * dim + i] = 0.5 * (tmp[k * dim + i] + 
+          tmp[(k + 1) * dim + i]);
+  }
+}
+
+// Search the intersections between the segment of control points 
+// 'ctrlA' on local parameters ['a0','a1'] and the segment of control
+// points 'ctrlB' on local parameters ['b0','b1'], and add them to the 
+// candidates of the SCurveIntersectTask 'task'
+// Return true if at least one intersection has been found
+bool _SCurveIntersectSeg(SCurveIntersectTask* const task, 
+  const float* const ctrlA, const float a0, const float a1,
+  const float* const ctrlB, const float b0, const float b1) {
+  int dim = task->_dim;
+  // Get the bounding boxes of the control points of the segments and 
+  // stop if they don't intersect
+  float extentA = 0.0;
+  float extentB = 0.0;
+  for (int i = dim; i--;) {
+    float minA = ctrlA[i];
+    float maxA = ctrlA[i];
+    for (int k = task->_orderA + 1; k--;) {
+      minA = MIN(minA, ctrlA[k * dim + i]);
+      maxA = MAX(maxA, ctrlA[k * dim + i]);
+    }
+    float minB = ctrlB[i];
+    float maxB = ctrlB[i];
+    for (int k = task->_orderB + 1; k--;) {
+      minB = MIN(minB, ctrlB[k * dim + i]);
+      maxB = MAX(maxB, ctrlB[k * dim + i]);
+    }
+    if (minA > maxB || minB > maxA)
+      return false;
+    extentA = MAX(extentA, maxA - minA);
+    extentB = MAX(extentB, maxB - minB);
+  }
+  // If the intervals have converged, add the intersection
+  if (a1 - a0 <= BCURVE_INTERSECTEPS && b1 - b0 <= BCURVE_INTERSECTEPS) {
+    _SCurveIntersectAddCand(task, task->_offA + 0.5 * (a0 + a1),
+      task->_offB + 0.5 * (b0 + b1));
+    return true;
+  }
+  // Intervals smaller than BCURVE_INTERSECTDUP contain at most one 
+  // intersection, the search stops at the first half giving one
+  bool single = 
+    (a1 - a0 < BCURVE_INTERSECTDUP && b1 - b0 < BCURVE_INTERSECTDUP);
+  // Split the segment with the largest bounding box, unless its 
+  // interval has already converged, and search each half
+  bool found = false;
+  if (a1 - a0 > BCURVE_INTERSECTEPS && 
+    (extentA >= extentB || b1 - b0 <= BCURVE_INTERSECTEPS)) {
+    float left[(task->_orderA + 1) * dim];
+    float right[(task->_orderA + 1) * dim];
+    _BCurveSplitCtrl(ctrlA, task->_orderA, dim, left, right);
+    float mid = 0.5 * (a0 + a1);
+    found = _SCurveIntersectSeg(task, left, a0, mid, ctrlB, b0, b1);
+    if (!found || !single)
+      found |= _SCurveIntersectSeg(task, right, mid, a1, ctrlB, b0, b1);
+  } else {
+    float left[(task->_orderB + 1) * dim];
+    float right[(task->_orderB + 1) * dim];
+    _BCurveSplitCtrl(ctrlB, task->_orderB, dim, left, right);
+    float mid = 0.5 * (b0 + b1);
+    found = _SCurveIntersectSeg(task, ctrlA, a0, a1, left, b0, mid);
+    if (!found || !single)
+      found |= _SCurveIntersectSeg(task, ctrlA, a0, a1, right, mid, b1);
+  }
+  return found;
 }
 
-// Add one segment at the head of the curve (controls are set to 
-// vectors null, except the last one which the first one of the current
-// first segment)
-void SCurveAddSegHead(SCurve* const that) {
-#if BUILDMODE == 0
-  if (that == NULL) {
-    BCurveErr->_type = PBErrTypeNullPointer;
-    sprintf(BCurveErr->_msg, "'that' is null");
-    PBErrCatch(BCurveErr);
+// Add the intersection at parameters 'u' and 'v' to the candidates of
+// the SCurveIntersectTask 'task'
+void _SCurveIntersectAddCand(SCurveIntersectTask* const task, 
+  const float u, const float v) {
+  // Grow the array of candidates if it's full
+  if (task->_nbCand == task->_capCand) {
+    task->_capCand = MAX(2 * task->_capCand, 16);
+    float* cand = PBErrMalloc(BCurveErr, 
+      sizeof(float) * 2 * task->_capCand);
+    if (task->_nbCand > 0)
+      memcpy(cand, task->_cand, sizeof(float) * 2 * task->_nbCand);
+    free(task->_cand);
+    task->_cand = cand;
   }
-#endif
-  // Create the new segment
-  BCurve* seg = BCurveCreate(that->_order, that->_dim);
-  // Free memory used by the last control point
-  VecFree(seg->_ctrl + that->_order);
-  // Replace it with the current first control
-  seg->_ctrl[that->_order] = GSetHead(&(that->_ctrl));
-  // Add the segment to the set of segment
-  GSetPush(&(that->_seg), seg);
-  // Add the new control points to the set of control points
-  for (int iCtrl = that->_order; iCtrl--;)
-    GSetPush(&(that->_ctrl), seg->_ctrl[iCtrl]);
-  // Update the number of segment
-  ++(that->_nbSeg);
+  task->_cand[2 * task->_nbCand] = u;
+  task->_cand[2 * task->_nbCand + 1] = v;
+  ++(task->_nbCand);
 }
 
-// Remove the first segment of the curve (which must have more than one
-// segment)
-void SCurveRemoveHeadSeg(SCurve* const that) {
+// Compare the candidate intersections 'a' and 'b' by their first, 
+// then second, parameter (cf qsort)
+int _SCurveIntersectCmp(const void* const a, const void* const b) {
+  const float* candA = a;
+  const float* candB = b;
+  if (candA[0] != candB[0])
+    return (candA[0] < candB[0] ? -1 : 1);
+  if (candA[1] != candB[1])
+    return (candA[1] < candB[1] ? -1 : 1);
+  return 0;
+}
+
+// Search the self-intersections of the segment of control points 
+// 'ctrl' on local parameters ['a0','a1'], at depth 'depth' of the 
+// search, and add them to the candidates of the SCurveIntersectTask 
+// 'task'
+void _SCurveIntersectSelfSeg(SCurveIntersectTask* const task, 
+  const float* const ctrl, const float a0, const float a1, 
+  const int depth) {
+  int order = task->_orderA;
+  int dim = task->_dim;
+  if (depth >= BCURVE_INTERSECTSELFDEPTH)
+    return;
+  // A segment whose control points are monotonic along one axis is 
+  // monotonic along this axis too and can't self-intersect
+  for (int i = dim; i--;) {
+    bool incr = true;
+    bool decr = true;
+    for (int k = order; k--;) {
+      float delta = ctrl[(k + 1) * dim + i] - ctrl[k * dim + i];
+      incr = incr && (delta >= 0.0);
+      decr = decr && (delta <= 0.0);
+    }
+    if (incr || decr)
+      return;
+  }
+  // Split the segment, search the intersections between the two 
+  // halves (their shared point is removed with the candidates at the
+  // same parameter on both halves) and inside each half
+  float left[(order + 1) * dim];
+  float right[(order + 1) * dim];
+  _BCurveSplitCtrl(ctrl, order, dim, left, right);
+  float mid = 0.5 * (a0 + a1);
+  _SCurveIntersectSeg(task, left, a0, mid, right, mid, a1);
+  _SCurveIntersectSelfSeg(task, left, a0, mid, depth + 1);
+  _SCurveIntersectSelfSeg(task, right, mid, a1, depth + 1);
+}
+
+// Search the intersections between the 'iSeg'-th segment of the 
+// SCurve 'that' and the 'jSeg'-th segment of the SCurve 'curve' and 
+// add them to the candidates of the SCurveIntersectTask 'task'
+void _SCurveIntersectSegPair(const SCurve* const that, const int iSeg,
+  const SCurve* const curve, const int jSeg, 
+  SCurveIntersectTask* const task) {
+  task->_offA = (float)iSeg;
+  task->_offB = (float)jSeg;
+  // Copy the control points of the segments
+  int dim = task->_dim;
+  float ctrlA[(task->_orderA + 1) * dim];
+  float ctrlB[(task->_orderB + 1) * dim];
+  for (int k = task->_orderA + 1; k--;)
+    memcpy(ctrlA + k * dim, 
+      that->_ctrlArr[(that->_iHead + iSeg) * task->_orderA + k]->_val, 
+      sizeof(float) * dim);
+  for (int k = task->_orderB + 1; k--;)
+    memcpy(ctrlB + k * dim, 
+      curve->_ctrlArr[(curve->_iHead + jSeg) * task->_orderB + k]->_val,
+      sizeof(float) * dim);
+  // If it's the same segment, search its self-intersections
+  if (that == curve && iSeg == jSeg)
+    _SCurveIntersectSelfSeg(task, ctrlA, 0.0, 1.0, 0);
+  // Else, search the intersections between the two segments (the 
+  // point shared by consecutive segments of the same SCurve is 
+  // removed with the candidates at the same parameter)
+  else
+    _SCurveIntersectSeg(task, ctrlA, 0.0, 1.0, ctrlB, 0.0, 1.0);
+}
+
+// Get the intersections between the SCurve 'that' and the SCurve 
+// 'curve' of same dimension, or the self-intersections of 'that' if 
+// 'curve' is null or equal to 'that'
+// Pairs of segments are pruned with the SCurveBVHs of the SCurves, 
+// then the intersections are searched by recursive subdivision of 
+// the segments
+// Return a GSetVecFloat of vectors of 2 values: the parameters of the 
+// intersection on 'that' and on 'curve' (on 'that' for the second 
+// value of self-intersections, which is always greater than the 
+// first one), sorted by increasing first value
+// The curve meeting itself at the same parameter, the end points 
+// shared by consecutive segments are not reported as 
+// self-intersections, nor the ones closer than BCURVE_INTERSECTDUP in
+// parameter
+// Not thread-safe: it may build the bounding volume hierarchy of 
+// the SCurve(s) (cf SCurveGetBVH)
+GSetVecFloat* SCurveGetIntersections(const SCurve* const that, 
+  const SCurve* const curve) {
 #if BUILDMODE == 0
   if (that == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
     sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
-  if (that->_nbSeg < 2) {
+  if (curve != NULL && curve->_dim != that->_dim) {
     BCurveErr->_type = PBErrTypeInvalidArg;
-    sprintf(BCurveErr->_msg, "'that' has only one segment");
+    sprintf(BCurveErr->_msg, "dimensions of the curves differ (%d==%d)",
+      that->_dim, curve->_dim);
     PBErrCatch(BCurveErr);
   }
 #endif
-  // Remove the control points from the set of control points
-  for (int iCtrl = 0; iCtrl < that->_order; ++iCtrl) {
-    VecFloat* ctrl = (VecFloat*)GSetPop(&(that->_ctrl));
-    VecFree(&ctrl);
+  const SCurve* other = (curve == NULL ? that : curve);
+  bool self = (other == that);
+  GSetVecFloat* res = GSetVecFloatCreate();
+  const SCurveBVH* bvhA = SCurveGetBVH(that);
+  const SCurveBVH* bvhB = SCurveGetBVH(other);
+  int dim = that->_dim;
+  SCurveIntersectTask task;
+  task._orderA = that->_order;
+  task._orderB = other->_order;
+  task._dim = dim;
+  task._cand = NULL;
+  task._nbCand = 0;
+  task._capCand = 0;
+  // Stack of the pairs of nodes to visit with the ranges of their 
+  // segments; for self-intersections the segments of the first node 
+  // are always before the ones of the second node, or the nodes are 
+  // the same
+  int stack[BCURVE_INTERSECTSTACK][6];
+  int nbStack = 1;
+  stack[0][0] = 0;
+  stack[0][1] = 0;
+  stack[0][2] = bvhA->_nbSeg;
+  stack[0][3] = 0;
+  stack[0][4] = 0;
+  stack[0][5] = bvhB->_nbSeg;
+  // Loop until there is no more pair of nodes to visit
+  while (nbStack > 0) {
+    --nbStack;
+    int* node = stack[nbStack];
+    int iNodeA = node[0];
+    int firstA = node[1];
+    int lastA = node[2];
+    int iNodeB = node[3];
+    int firstB = node[4];
+    int lastB = node[5];
+    // Skip the pair if the bounding boxes of the nodes don't intersect
+    if (!_SCurveBVHMatch(bvhA->_bound + 2 * dim * iNodeA, dim, 0, 
+      bvhB->_bound + 2 * dim * iNodeB, 
+      bvhB->_bound + 2 * dim * iNodeB + dim, 0.0))
+      continue;
+    bool leafA = (lastA - firstA <= BCURVE_BVHLEAFSIZE);
+    bool leafB = (lastB - firstB <= BCURVE_BVHLEAFSIZE);
+    bool sameNode = (self && iNodeA == iNodeB);
+    // If both nodes are leaves, search the pairs of segments whose 
+    // bounding boxes intersect
+    if (leafA && leafB) {
+      for (int iSeg = firstA; iSeg < lastA; ++iSeg) {
+        for (int jSeg = (sameNode ? iSeg : firstB); jSeg < lastB; 
+          ++jSeg) {
+          const float* boundB = bvhB->_segBound + 2 * dim * jSeg;
+          if (_SCurveBVHMatch(bvhA->_segBound + 2 * dim * iSeg, dim, 0,
+            boundB, boundB + dim, 0.0))
+            _SCurveIntersectSegPair(that, iSeg, other, jSeg, &task);
+        }
+      }
+    // Else, if it's the same node, search the pairs of its children
+    } else if (sameNode) {
+      int mid = (firstA + lastA) / 2;
+      int iLeft = 2 * iNodeA + 1;
+      int iRight = 2 * iNodeA + 2;
+      int pairs[3][6] = {
+        {iLeft, firstA, mid, iLeft, firstA, mid},
+        {iLeft, firstA, mid, iRight, mid, lastA},
+        {iRight, mid, lastA, iRight, mid, lastA}};
+      memcpy(stack[nbStack], pairs, sizeof(pairs));
+      nbStack += 3;
+    // Else, split the node with the most segments
+    } else if (!leafA && (leafB || lastA - firstA >= lastB - firstB)) {
+      int mid = (firstA + lastA) / 2;
+      int pairs[2][6] = {
+        {2 * iNodeA + 1, firstA, mid, iNodeB, firstB, lastB},
+        {2 * iNodeA + 2, mid, lastA, iNodeB, firstB, lastB}};
+      memcpy(stack[nbStack], pairs, sizeof(pairs));
+      nbStack += 2;
+    } else {
+      int mid = (firstB + lastB) / 2;
+      int pairs[2][6] = {
+        {iNodeA, firstA, lastA, 2 * iNodeB + 1, firstB, mid},
+        {iNodeA, firstA, lastA, 2 * iNodeB + 2, mid, lastB}};
+      memcpy(stack[nbStack], pairs, sizeof(pairs));
+      nbStack += 2;
+    }
   }
-  // Remove the first segment
-  BCurve* seg = (BCurve*)GSetPop(&(that->_seg));
-  // Disconnect the control points which have been already freed
-  // or doesn't need to be freed (the last one)
-  for (int iCtrl = 0; iCtrl <= that->_order; ++iCtrl)
-    seg->_ctrl[iCtrl] = NULL;
-  // Free the memory used by the segment
-  BCurveFree(&seg);
-  // Update the number of segment
-  --(that->_nbSeg);
+  // Sort the candidates by their parameters, and keep, in one pass, 
+  // the ones which are not the same intersection as a kept one: the 
+  // kept ones closer than BCURVE_INTERSECTDUP on the first parameter 
+  // are the last ones
+  qsort(task._cand, task._nbCand, sizeof(float) * 2, 
+    _SCurveIntersectCmp);
+  long nbKept = 0;
+  for (long iCand = 0; iCand < task._nbCand; ++iCand) {
+    float u = task._cand[2 * iCand];
+    float v = task._cand[2 * iCand + 1];
+    // A curve meeting itself at the same parameter, the points shared
+    // by consecutive segments or halves of a segment are not 
+    // self-intersections
+    bool keep = !(self && fabs(v - u) < BCURVE_INTERSECTDUP);
+    long iKept = nbKept - 1;
+    while (keep && iKept >= 0 && 
+      u - task._cand[2 * iKept] < BCURVE_INTERSECTDUP) {
+      keep = (fabs(v - task._cand[2 * iKept + 1]) >= 
+        BCURVE_INTERSECTDUP);
+      --iKept;
+    }
+    if (keep) {
+      task._cand[2 * nbKept] = u;
+      task._cand[2 * nbKept + 1] = v;
+      ++nbKept;
+      VecFloat* inter = VecFloatCreate(2);
+      VecSet(inter, 0, u);
+      VecSet(inter, 1, v);
+      GSetAppend(res, inter);
+      GSetElemSetSortVal((GSetElem*)GSetTailElem(res), u);
+    }
+  }
+  free(task._cand);
+  // Return the intersections
+  return res;
 }
 
-// Remove the last segment of the curve (which must have more than one
-// segment)
-void SCurveRemoveTailSeg(SCurve* const that) {
+// -------------- SCurveFitter
+
+// ================ Functions implementation ====================
+
+// Create a new SCurveFitter for points of dimension 'dim', with a 
+// tolerance 'tolerance' on the distance between the points and the 
+// fitted curve and a window of at most 'capWindow' points (at least 
+// 4)
+SCurveFitter* SCurveFitterCreate(const int dim, const float tolerance,
+  const int capWindow) {
 #if BUILDMODE == 0
-  if (that == NULL) {
-    BCurveErr->_type = PBErrTypeNullPointer;
-    sprintf(BCurveErr->_msg, "'that' is null");
+  if (dim < 1) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'dim' is invalid (%d>0)", dim);
     PBErrCatch(BCurveErr);
   }
-  if (that->_nbSeg < 2) {
+  if (tolerance < 0.0) {
     BCurveErr->_type = PBErrTypeInvalidArg;
-    sprintf(BCurveErr->_msg, "'that' has only one segment");
+    sprintf(BCurveErr->_msg, "'tolerance' is invalid (%f>=0.0)", 
+      tolerance);
+    PBErrCatch(BCurveErr);
+  }
+  if (capWindow < 4) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "'capWindow' is invalid (%d>=4)", 
+      capWindow);
     PBErrCatch(BCurveErr);
   }
 #endif
-  // Remove the control points from the set of control points
-  for (int iCtrl = 0; iCtrl < that->_order; ++iCtrl) {
-    VecFloat* ctrl = (VecFloat*)GSetDrop(&(that->_ctrl));
-    VecFree(&ctrl);
+  // Allocate memory
+  SCurveFitter* that = PBErrMalloc(BCurveErr, sizeof(SCurveFitter));
+  // Set the properties
+  that->_dim = dim;
+  that->_tolerance = tolerance;
+  that->_capWindow = capWindow;
+  that->_nbPoint = 0;
+  that->_nbValid = 0;
+  that->_curve = NULL;
+  that->_first = VecFloatCreate(dim);
+  that->_last = VecFloatCreate(dim);
+  that->_momentPoint = PBErrMalloc(BCurveErr, sizeof(double) * 3 * dim);
+  for (int iCtrl = 4; iCtrl--;) {
+    that->_fit[iCtrl] = VecFloatCreate(dim);
+    that->_valid[iCtrl] = VecFloatCreate(dim);
   }
-  // Remove the last segment
-  BCurve* seg = (BCurve*)GSetDrop(&(that->_seg));
-  // Disconnect the control points which have been already freed
-  // or doesn't need to be freed (the first one)
-  for (int iCtrl = 0; iCtrl <= that->_order; ++iCtrl)
-    seg->_ctrl[iCtrl] = NULL;
-  // Free the memory used by the segment
-  BCurveFree(&seg);
-  // Update the number of segment
-  --(that->_nbSeg);
+  // Return the new SCurveFitter
+  return that;
 }
 
-// Get the bounding box of the SCurve.
-// Return a Facoid whose axis are aligned on the standard coordinate 
-// system.
-// TODO : better solution possible, refer to 
-// https://pomax.github.io/bezierinfo/#circles_cubic
-Facoid* SCurveGetBoundingBox(const SCurve* const that) {
+// Free the memory used by the SCurveFitter 'that' and the SCurve it 
+// contains
+void SCurveFitterFree(SCurveFitter** that) {
+  // Check argument
+  if (that == NULL || *that == NULL)
+    return;
+  // Free memory
+  VecFree(&((*that)->_first));
+  VecFree(&((*that)->_last));
+  free((*that)->_momentPoint);
+  for (int iCtrl = 4; iCtrl--;) {
+    VecFree((*that)->_fit + iCtrl);
+    VecFree((*that)->_valid + iCtrl);
+  }
+  SCurveFree(&((*that)->_curve));
+  free(*that);
+  *that = NULL;
+}
+
+// Add the point 'point' at the end of the stream fitted by the 
+// SCurveFitter 'that'
+// If the fitting of the window exceeds the tolerance or the window is
+// full, a segment is appended to the SCurve of 'that' with 
+// SCurveAddSegTail
+// The cost per point is constant and nothing is allocated, except 
+// by the emission of a segment. The SCurve of emitted segments grows 
+// with the stream until it is taken by SCurveFitterDrain or 
+// SCurveFitterFlush
+void SCurveFitterAdd(SCurveFitter* const that, 
+  const VecFloat* const point) {
 #if BUILDMODE == 0
   if (that == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
     sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
-#endif
-  // Declare a set to memorize the bounding box of each segment
-  GSetShapoid set = GSetShapoidCreateStatic();
-  // For each segment
-  GSetIterForward iter = GSetIterForwardCreateStatic(&(that->_seg));
-  do {
-    // Add the bounding box of this segment to the set
-    GSetPush(&set, 
-      BCurveGetBoundingBox((BCurve*)GSetIterGet(&iter)));
-  } while (GSetIterStep(&iter));
-  // Get the bounding box of all the segment's bounding box
-  Facoid* bound = ShapoidGetBoundingBoxSet(&set);
-  // Free the memory used by the bounding box of each segment
-  iter = GSetIterForwardCreateStatic(&set);
-  do {
-    Facoid* facoid = (Facoid*)GSetIterGet(&iter);
-    ShapoidFree(&facoid);
-  } while (GSetIterStep(&iter));
-  GSetFlush(&set);
-  // Return the bounding box
-  return bound;
-}
-
-// Create a new SCurve from the outline of the Facoid 'shap'
-// The Facoid must be of dimension 2
-// Control points are ordered CCW of the Shapoid
-SCurve* SCurveCreateFromFacoid(const Facoid* const shap) {
-#if BUILDMODE == 0
-  if (shap == NULL) {
+  if (point == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
-    sprintf(BCurveErr->_msg, "'shap' is null");
+    sprintf(BCurveErr->_msg, "'point' is null");
     PBErrCatch(BCurveErr);
   }
-  if (ShapoidGetDim(shap) != 2) {
+  if (VecGetDim(point) != that->_dim) {
     BCurveErr->_type = PBErrTypeInvalidArg;
-    sprintf(BCurveErr->_msg, 
-      "'shap' 's dimension is invalid (%d==2)", 
-      ShapoidGetDim(shap));
+    sprintf(BCurveErr->_msg, "'point' 's dimension is invalid (%ld=%d)",
+      VecGetDim(point), that->_dim);
     PBErrCatch(BCurveErr);
   }
 #endif
-  // Create the curve
-  int order = 1;
-  int dim = 2;
-  int nbSeg = 4;
-  SCurve* ret = SCurveCreate(order, dim, nbSeg);
-  // Set the coordinates of the control points according to the 
-  // Facoid
-  VecFloat* v = VecClone(ShapoidPos(shap));
-  SCurveSetCtrl(ret, 0, v);
-  SCurveSetCtrl(ret, 4, v);
-  VecOp(v, 1.0, ShapoidAxis(shap, 0), 1.0);
-  SCurveSetCtrl(ret, 1, v);
-  VecOp(v, 1.0, ShapoidAxis(shap, 1), 1.0);
-  SCurveSetCtrl(ret, 2, v);
-  VecOp(v, 1.0, ShapoidAxis(shap, 0), -1.0);
-  SCurveSetCtrl(ret, 3, v);
-  VecFree(&v);
-  // Return the curve
-  return ret;
+  // If it's the first point of the stream, start the window with it
+  if (that->_nbPoint == 0) {
+    _SCurveFitterRestart(that, point);
+    that->_nbValid = 1;
+    return;
+  }
+  // Add the point to the window
+  _SCurveFitterAccumulate(that, point);
+  // If the fitting of the window is within the tolerance (the fitting
+  // of two points is exact)
+  if (_SCurveFitterFit(that, that->_fit) == true || 
+    that->_nbPoint == 2) {
+    // Memorize it as the last valid fitting
+    for (int iCtrl = 4; iCtrl--;) {
+      VecFloat* ctrl = that->_valid[iCtrl];
+      that->_valid[iCtrl] = that->_fit[iCtrl];
+      that->_fit[iCtrl] = ctrl;
+    }
+    that->_nbValid = that->_nbPoint;
+    // If the window is full
+    if (that->_nbPoint == that->_capWindow) {
+      // Emit the fitting and restart the window from its last point
+      _SCurveFitterEmit(that, that->_valid);
+      _SCurveFitterRestart(that, point);
+      that->_nbValid = 1;
+    }
+  // Else, the fitting of the window exceeds the tolerance
+  } else {
+    // Emit the last valid fitting, which ends at the previous point, 
+    // and restart the window from the previous point, which is the 
+    // last control point of the emitted segment
+    _SCurveFitterEmit(that, that->_valid);
+    _SCurveFitterRestart(that, that->_valid[3]);
+    _SCurveFitterAccumulate(that, point);
+    (void)_SCurveFitterFit(that, that->_valid);
+    that->_nbValid = 2;
+  }
 }
 
-// Create a new SCurve from the outline of the Pyramidoid 'shap'
-// The Pyramidoid must be of dimension 2
-// Control points are ordered CCW of the Shapoid
-SCurve* SCurveCreateFromPyramidoid(const Pyramidoid* const shap) {
+// Return the SCurve made of the segments emitted by the SCurveFitter 
+// 'that' since the last call to SCurveFitterDrain or 
+// SCurveFitterFlush, NULL if there is none
+// The user becomes responsible for freeing the returned SCurve. The 
+// fitting of the stream continues, and the first control point of 
+// the next emitted segment is the last one of the returned SCurve
+SCurve* SCurveFitterDrain(SCurveFitter* const that) {
 #if BUILDMODE == 0
-  if (shap == NULL) {
+  if (that == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
-    sprintf(BCurveErr->_msg, "'shap' is null");
+    sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
-  if (ShapoidGetDim(shap) != 2) {
-    BCurveErr->_type = PBErrTypeInvalidArg;
-    sprintf(BCurveErr->_msg, 
-      "'shap' 's dimension is invalid (%d==2)", 
-      ShapoidGetDim(shap));
+#endif
+  // Give the SCurve to the user, the next emitted segment will create
+  // a new one
+  SCurve* curve = that->_curve;
+  that->_curve = NULL;
+  return curve;
+}
+
+// Append the fitting of the points remaining in the window of the 
+// SCurveFitter 'that' to its SCurve, and return this SCurve
+// The user becomes responsible for freeing the returned SCurve, and 
+// 'that' is reset to start fitting a new stream
+// Return NULL if less than 2 points have been given to 'that' since 
+// the last call to SCurveFitterDrain or SCurveFitterFlush
+SCurve* SCurveFitterFlush(SCurveFitter* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
 #endif
-  // Create the curve
-  SCurve* ret = SCurveCreate(1, 2, 3);
-  // Set the coordinates of the control points according to the 
-  // Facoid
-  VecFloat* ctrl[2] = {NULL};
-  for (int i = 2; i--;) {
-    ctrl[i] = VecClone(ShapoidPos(shap));
-  }
-  VecOp(ctrl[0], 1.0, ShapoidAxis(shap, 0), 1.0);
-  VecOp(ctrl[1], 1.0, ShapoidAxis(shap, 1), 1.0);
-  SCurveSetCtrl(ret, 0, ShapoidPos(shap));
-  SCurveSetCtrl(ret, 1, ctrl[0]);
-  SCurveSetCtrl(ret, 2, ctrl[1]);
-  SCurveSetCtrl(ret, 3, ShapoidPos(shap));
-  for (int i = 2; i--;)
-    VecFree(ctrl + i);
-  // Return the curve
-  return ret;
+  // If there are points in the window not yet emitted
+  if (that->_nbValid > 1)
+    _SCurveFitterEmit(that, that->_valid);
+  // Reset the SCurveFitter and return the SCurve
+  that->_nbPoint = 0;
+  that->_nbValid = 0;
+  return SCurveFitterDrain(that);
 }
 
-// Create a new SCurve from the outline of the Spheroid 'shap'
-// The Spheroid must be of dimension 2
-// Control points are ordered CCW of the Shapoid
-// Calculate an approximation as there is no exact solution
-SCurve* SCurveCreateFromSpheroid(const Spheroid* const shap) {
+// Restart the window of the SCurveFitter 'that' with the point 
+// 'point' as its first point
+void _SCurveFitterRestart(SCurveFitter* const that, 
+  const VecFloat* const point) {
 #if BUILDMODE == 0
-  if (shap == NULL) {
+  if (that == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
-    sprintf(BCurveErr->_msg, "'shap' is null");
+    sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
-  if (ShapoidGetDim(shap) != 2) {
-    BCurveErr->_type = PBErrTypeInvalidArg;
-    sprintf(BCurveErr->_msg, 
-      "'shap' 's dimension is invalid (%d==2)", 
-      ShapoidGetDim(shap));
+  if (point == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'point' is null");
     PBErrCatch(BCurveErr);
   }
 #endif
-  // Create the curve
-  SCurve* ret = SCurveCreate(3, 2, 4);
-  // Set the control points
-  // The anchors of the curve can be easily calculated from the 
-  // position and axis of the Spheroid
-  int iAxis = 0;
-  float coeff = 0.5;
-  VecFloat* ctrl[13] = {NULL};
-  for (int i = 13; i--;)
-    ctrl[i] = VecFloatCreate(2);
-  for (int i = 0; i < 12; i += 3) {
-    VecCopy(ctrl[i], ShapoidPos(shap));
-    if (i == 6)
-      coeff *= -1.0;
-    VecOp(ctrl[i], 1.0, ShapoidAxis(shap, iAxis), coeff);
-    if (i > 0)
-      VecCopy(ctrl[i - 1], ctrl[i]);
-    if (i < 11)
-      VecCopy(ctrl[i + 1], ctrl[i]);
-    iAxis = (iAxis == 0 ? 1 : 0);
-  }
-  VecCopy(ctrl[12], ctrl[0]);
-  VecCopy(ctrl[11], ctrl[0]);
-  // Calculate the others control points by transforming the 
-  // quadratic approximation of a quarter of the unit circle :
-  // A(1,0), B(1,4(sqrt(2)-1)/3), C(4(sqrt(2)-1)/3,1), D(0,1)
-  // toward the Spheroid
-  float c = 0.276142;
-  VecOp(ctrl[1], 1.0, ShapoidAxis(shap, 1), c);
-  VecOp(ctrl[2], 1.0, ShapoidAxis(shap, 0), c);
-  VecOp(ctrl[4], 1.0, ShapoidAxis(shap, 0), -1.0 * c);
-  VecOp(ctrl[5], 1.0, ShapoidAxis(shap, 1), c);
-  VecOp(ctrl[7], 1.0, ShapoidAxis(shap, 1), -1.0 * c);
-  VecOp(ctrl[8], 1.0, ShapoidAxis(shap, 0), -1.0 * c);
-  VecOp(ctrl[10], 1.0, ShapoidAxis(shap, 0), c);
-  VecOp(ctrl[11], 1.0, ShapoidAxis(shap, 1), -1.0 * c);
-  for (int i = 13; i--;)
-    SCurveSetCtrl(ret, i, ctrl[i]);
-  for (int i = 13; i--;)
-    VecFree(ctrl + i);
-  // Return the curve
-  return ret;
+  // The copy is done first as 'point' may be one of the control 
+  // points of the fitter
+  VecCopy(that->_first, point);
+  VecCopy(that->_last, point);
+  that->_nbPoint = 1;
+  that->_length = 0.0;
+  that->_sqrNorm = 0.0;
+  for (int k = 5; k--;)
+    that->_moment[k] = 0.0;
+  for (int i = 3 * that->_dim; i--;)
+    that->_momentPoint[i] = 0.0;
 }
 
-// Get the distance between the SCurve 'that' and the SCurve 'curve'
-// The distance is defined as the integral of 
-// ||'that'(u(t))-'curve'(v(t))|| where u and v are the relative 
-// positions on the curve over t varying from 0.0 to 1.0
-float SCurveGetDistToCurve(const SCurve* const that, 
-  const SCurve* const curve) {
+// Add the point 'point' at the end of the window of the SCurveFitter
+// 'that' and update the moments of the window
+void _SCurveFitterAccumulate(SCurveFitter* const that, 
+  const VecFloat* const point) {
 #if BUILDMODE == 0
   if (that == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
-    sprintf(BCurveErr->_msg, "'shap' is null");
+    sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
-  if (curve == NULL) {
+  if (point == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
-    sprintf(BCurveErr->_msg, "'shap' is null");
-    PBErrCatch(BCurveErr);
-  }
-  if (SCurveGetDim(that) != SCurveGetDim(curve)) {
-    BCurveErr->_type = PBErrTypeInvalidArg;
-    sprintf(BCurveErr->_msg, 
-      "dimensions of 'that' and 'curve' differ (%d==%d)",
-      SCurveGetDim(that), SCurveGetDim(curve));
+    sprintf(BCurveErr->_msg, "'point' is null");
     PBErrCatch(BCurveErr);
   }
 #endif
-  // Declare a variable to memorize the result
-  float res = 0.0;
-  // Declare a variable to memorize the step over parameter
-  float dt = 0.01;
-  int nb = (int)floor(1.0 / dt); 
-  float t = 0.0;
-  // Loop over the parameter
-  for (int i = nb; i--;) {
-    // Calculate the relative parameter for both curves
-    float u = t * SCurveGetMaxU(that);
-    float v = t * SCurveGetMaxU(curve);
-    // Get the value of both curve at these relative parameters
-    VecFloat* valA = SCurveGet(that, u);
-    VecFloat* valB = SCurveGet(curve, v);
-    // Get the distance between value
-    float dist = VecDist(valA, valB);
-    // Add to result
-    res += dist * dt;
-    // Step the parameter
-    t += dt;
-    // Free memory
-    VecFree(&valA);
-    VecFree(&valB);
+  // Update the length of the polyline
+  that->_length += VecDist(that->_last, point);
+  VecCopy(that->_last, point);
+  ++(that->_nbPoint);
+  // Update the moments
+  double s = that->_length;
+  double sk = s * s;
+  for (int k = 0; k < 5; ++k) {
+    that->_moment[k] += sk;
+    sk *= s;
   }
-  // Return the result
-  return res;
-}
-
-// Apply the chaikin curve subdivision algorithm to the SCurve 'that'
-// with 'depth' times recursion and 'strength' is the parametric
-// distance from each corner where the curve is cut at each recursion
-// 'strength' in [0.0, 1.0]
-// The SCurve must be of order 1, if it is not nothing happens
-// cf http://graphics.cs.ucdavis.edu/education/CAGDNotes/Chaikins-Algorithm.pdf
-SCurve* SCurveChaikinSubdivision(SCurve* const that, 
-  const float strength, const unsigned int depth) {
+  int dim = that->_dim;
+  for (int iDim = dim; iDim--;) {
+    double q = (double)(point->_val[iDim]) - 
+      (double)(that->_first->_val[iDim]);
+    that->_sqrNorm += q * q;
+    that->_momentPoint[iDim] += s * q;
+    that->_momentPoint[dim + iDim] += s * s * q;
+    that->_momentPoint[2 * dim + iDim] += s * s * s * q;
+  }
+}
+
+// Fit the points in the window of the SCurveFitter 'that' with the 
+// control points 'ctrl'
+// Return true if the sum of the squared distances between the points 
+// and the fitted segment is below the square of the tolerance of 
+// 'that'
+bool _SCurveFitterFit(SCurveFitter* const that, VecFloat** const ctrl) {
 #if BUILDMODE == 0
   if (that == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
     sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
-  if (strength < 0.0 || strength > 1.0) {
-    BCurveErr->_type = PBErrTypeInvalidArg;
-    sprintf(BCurveErr->_msg, "'strength' is invalid (0<=%f<=1)", 
-      strength);
+  if (ctrl == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'ctrl' is null");
     PBErrCatch(BCurveErr);
   }
 #endif
-
-  // Init the result with a clone of the original curve
-  SCurve* res = SCurveClone(that);
-
-  // If the SCurve order is 0
-  if (SCurveGetOrder(that) == 1) {
-
-    // Loop on the depth
-    for (unsigned int iDepth = depth; iDepth--;) {
-
-      // Declare the new set of BCurve
-      GSetBCurve segs = GSetBCurveCreateStatic();
-
-      // Declare the new set of control points
-      GSetVecFloat ctrls = GSetVecFloatCreateStatic();
-
-      // Declare a variable to memorize the new segment
-      BCurve* newSeg = NULL;
-      
-      // Loop on the segments of the curve
-      GSetIterForward iter = GSetIterForwardCreateStatic(
-        SCurveSegs(res));
-      do {
-
-        // Get the current segment
-        BCurve* curSeg = GSetIterGet(&iter);
-
-        // If it's the first segment
-        if (GSetIterIsFirst(&iter)) {
-          
-          // Get the cut position
-          VecFloat* pos = BCurveGet(curSeg, 1.0 - strength);
-
-          // Create the new segment for the head of the current segment
-          newSeg = BCurveCreate(SCurveGetOrder(that), 
-            SCurveGetDim(that));
-          VecFree(newSeg->_ctrl);
-          VecFree(newSeg->_ctrl + 1);
-          newSeg->_ctrl[0] = VecClone(curSeg->_ctrl[0]);
-          newSeg->_ctrl[1] = pos;
-          
-          // Add the new segment
-          GSetAppend(&segs, newSeg);
-          GSetAppend(&ctrls, newSeg->_ctrl[0]);
-          GSetAppend(&ctrls, newSeg->_ctrl[1]);
-          
-          // Create the new segment for the tail of the current segment
-          // The second control of this segment will be set later
-          newSeg = BCurveCreate(SCurveGetOrder(that), 
-            SCurveGetDim(that));
-          VecFree(newSeg->_ctrl);
-          VecFree(newSeg->_ctrl + 1);
-          newSeg->_ctrl[0] = pos;
-          
-          // Add the new segment
-          GSetAppend(&segs, newSeg);
-          
-        // Else, if it's the last segment
-        } else if (GSetIterIsLast(&iter)) {
-          
-          // Get the cut position
-          VecFloat* pos = BCurveGet(curSeg, strength);
-
-          // Set the control of the last new segment
-          newSeg->_ctrl[1] = pos;
-          GSetAppend(&ctrls, newSeg->_ctrl[1]);
-          
-          // Create the new segment for the tail of the current segment
-          // The second control of this segment will be set later
-          newSeg = BCurveCreate(SCurveGetOrder(that), 
-            SCurveGetDim(that));
-          VecFree(newSeg->_ctrl);
-          VecFree(newSeg->_ctrl + 1);
-          newSeg->_ctrl[0] = pos;
-          newSeg->_ctrl[1] = VecClone(curSeg->_ctrl[1]);
-          
-          // Add the new segment
-          GSetAppend(&segs, newSeg);
-          GSetAppend(&ctrls, newSeg->_ctrl[1]);
-          
-        // Else, it's a segment inside the curve
-        } else {
-          
-          // Get the cut positions
-          VecFloat* posA = BCurveGet(curSeg, strength);
-          VecFloat* posB = BCurveGet(curSeg, 1.0 - strength);
-
-          // Set the second control of the last new segment
-          newSeg->_ctrl[1] = posA;
-          GSetAppend(&ctrls, newSeg->_ctrl[1]);
-          
-          // Create the new segment for the center of the current segment
-          newSeg = BCurveCreate(SCurveGetOrder(that), 
-            SCurveGetDim(that));
-          VecFree(newSeg->_ctrl);
-          VecFree(newSeg->_ctrl + 1);
-          newSeg->_ctrl[0] = posA;
-          newSeg->_ctrl[1] = posB;
-          
-          // Add the new segment
-          GSetAppend(&segs, newSeg);
-          GSetAppend(&ctrls, newSeg->_ctrl[1]);
-          
-          // Create the new segment for the tail of the current segment
-          // The second control of this segment will be set later
-          newSeg = BCurveCreate(SCurveGetOrder(that), 
-            SCurveGetDim(that));
-          VecFree(newSeg->_ctrl);
-          VecFree(newSeg->_ctrl + 1);
-          newSeg->_ctrl[0] = posB;
-          
-          // Add the new segment
-          GSetAppend(&segs, newSeg);
-          
-        }
-      } while (GSetIterStep(&iter));
-
-      // Free the current result
-      SCurveFree(&res);
-
-      // Create the new result SCurve
-      res = SCurveCreate(
-        SCurveGetOrder(that), SCurveGetDim(that), 1);
-      GSetFlush(&(res->_ctrl));
-      BCurve* curve = GSetPop((GSet*)SCurveSegs(res));
-      BCurveFree(&curve);
-      res->_seg = segs;
-      res->_ctrl = ctrls;
-      res->_nbSeg = GSetNbElem(SCurveSegs(res));
-
+  int dim = that->_dim;
+  double length = that->_length;
+  // If the points are all at the same position, the segment is 
+  // reduced to this position
+  if (length < PBMATH_EPSILON) {
+    for (int iCtrl = 4; iCtrl--;)
+      VecCopy(ctrl[iCtrl], that->_last);
+    return (that->_sqrNorm <= 
+      (double)(that->_tolerance) * (double)(that->_tolerance));
+  }
+  // The segment is Q(t)=P0+c1.t+c2.t^2+c3.t^3 where t=s/length, and 
+  // with Q(1) equal to the last point, c1=PL-P0-c2-c3
+  // Get the moments of t from the moments of s
+  double m[7];
+  double lk = length * length;
+  for (int k = 2; k < 7; ++k) {
+    m[k] = that->_moment[k - 2] / lk;
+    lk *= length;
+  }
+  // Normal equations of the least squares on c2 and c3, shared by all
+  // the dimensions, with a penalty toward the straight segment to keep
+  // them solvable
+  double a00 = m[4] - 2.0 * m[3] + m[2];
+  double a01 = m[5] - m[4] - m[3] + m[2];
+  double a11 = m[6] - 2.0 * m[4] + m[2];
+  double lambda = BCURVE_FITSMOOTH * (a00 + a11);
+  double det = (a00 + lambda) * (a11 + lambda) - a01 * a01;
+  // Solve for each dimension and sum the squared residuals
+  double residual = that->_sqrNorm;
+  for (int iDim = dim; iDim--;) {
+    double p0 = that->_first->_val[iDim];
+    double ql = (double)(that->_last->_val[iDim]) - p0;
+    double mq1 = that->_momentPoint[iDim] / length;
+    double mq2 = that->_momentPoint[dim + iDim] / (length * length);
+    double mq3 = 
+      that->_momentPoint[2 * dim + iDim] / (length * length * length);
+    double r2 = mq2 - mq1 - ql * (m[3] - m[2]);
+    double r3 = mq3 - mq1 - ql * (m[4] - m[2]);
+    double c2 = 0.0;
+    double c3 = 0.0;
+    if (det > 0.0) {
+      c2 = ((a11 + lambda) * r2 - a01 * r3) / det;
+      c3 = ((a00 + lambda) * r3 - a01 * r2) / det;
     }
+    double c1 = ql - c2 - c3;
+    residual += ql * ql * m[2] - 2.0 * ql * mq1 - 
+      2.0 * (c2 * r2 + c3 * r3) + 
+      c2 * c2 * a00 + 2.0 * c2 * c3 * a01 + c3 * c3 * a11;
+    // Convert to the Bernstein basis
+    ctrl[0]->_val[iDim] = p0;
+    ctrl[1]->_val[iDim] = p0 + c1 / 3.0;
+    ctrl[2]->_val[iDim] = p0 + (2.0 * c1 + c2) / 3.0;
+    ctrl[3]->_val[iDim] = that->_last->_val[iDim];
   }
-
-  // Return the result
-  return res;
+  // Return the success flag
+  return (residual <= 
+    (double)(that->_tolerance) * (double)(that->_tolerance));
 }
 
-// -------------- SCurveIter
-
-// ================ Functions implementation ====================
-
-// Create a new SCurveIter attached to the SCurve 'curve' with a step 
-// of 'delta'
-SCurveIter SCurveIterCreateStatic(const SCurve* const curve, 
-  const float delta) {
+// Append the segment with control points 'ctrl' at the end of the 
+// SCurve of the SCurveFitter 'that'
+void _SCurveFitterEmit(SCurveFitter* const that, 
+  VecFloat* const* const ctrl) {
 #if BUILDMODE == 0
-  if (curve == NULL) {
+  if (that == NULL) {
     BCurveErr->_type = PBErrTypeNullPointer;
-    sprintf(BCurveErr->_msg, "'curve' is null");
+    sprintf(BCurveErr->_msg, "'that' is null");
     PBErrCatch(BCurveErr);
   }
-  if (delta <= 0.0) {
-    BCurveErr->_type = PBErrTypeInvalidArg;
-    sprintf(BCurveErr->_msg, "'delta' is invalid (%f>0)", delta);
+  if (ctrl == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'ctrl' is null");
     PBErrCatch(BCurveErr);
   }
-#endif  
-  // Declare the new SCurveIter
-  SCurveIter iter;
-  // Set the properties
-  iter._curve = curve;
-  iter._curPos = 0.0;
-  iter._delta = delta;
-  // Return the new iterator
-  return iter;
+#endif
+  // If it's the first segment, create the SCurve, else add a segment
+  // at its end, whose first control point is the current last one
+  int iFirst = 0;
+  if (that->_curve == NULL) {
+    that->_curve = SCurveCreate(3, that->_dim, 1);
+  } else {
+    SCurveAddSegTail(that->_curve);
+    iFirst = 1;
+  }
+  // Set the control points of the new segment
+  int iCtrl = SCurveGetNbCtrl(that->_curve) - 4;
+  for (int i = iFirst; i < 4; ++i)
+    SCurveSetCtrl(that->_curve, iCtrl + i, ctrl[i]);
 }
 
 // -------------- BBody
@@ -1420,6 +4619,9 @@ BBody* BBodyCreate(const int order, const VecShort2D* const dim) {
   // Init pointers
   *((VecShort2D*)&(that->_dim)) = VecShortCreateStatic2D();
   that->_ctrl = NULL;
+  that->_bound = NULL;
+  that->_tightBound = NULL;
+  that->_center = NULL;
   // Init properties
   *((int*)&(that->_order)) = order;
   *((VecShort2D*)&(that->_dim)) = *dim;
@@ -1443,6 +4645,7 @@ void BBodyFree(BBody** that) {
   for (int iCtrl = nbCtrl; iCtrl--;)
     VecFree((*that)->_ctrl + iCtrl);
   free((*that)->_ctrl);
+  _BBodyInvalidateCache(*that);
   free(*that);
   *that = NULL;
 }
@@ -1468,12 +4671,6 @@ VecFloat* _BBodyGet(const BBody* const that, const VecFloat* const u) {
     PBErrCatch(BCurveErr);
   }
 #endif
-  // Get the weights of the control
-  VecFloat* weights =
-    BBodyGetWeightCtrlPt(
-      that,
-      u);
-
   // Allocate memory for the result
   int nbDimOut =
     VecGet(
@@ -1481,33 +4678,229 @@ VecFloat* _BBodyGet(const BBody* const that, const VecFloat* const u) {
       1);
   VecFloat* res = VecFloatCreate(nbDimOut);
 
-  // Get the result. This is the sum of the control points multiplied
-  // by their coefficient
-  int nbCtrl = BBodyGetNbCtrl(that);
-  for (
-    int iCtrl = nbCtrl;
-    iCtrl--;) {
+  // If there is an unrolled evaluation for this order and input 
+  // dimension
+  bool isSpecialized =
+    _BBodyGetSpecialized(
+      that,
+      u,
+      res);
+  if (isSpecialized == true) {
 
-    float weight =
-      VecGet(
-        weights,
-        iCtrl);
-    VecOp(
-      res,
-      1.0,
-      that->_ctrl[iCtrl],
-      weight);
+    // Return the result
+    return res;
 
   }
 
+  // Get the result by contraction of the control points one input at
+  // a time
+  float* scratch =
+    PBErrMalloc(
+      BCurveErr,
+      sizeof(float) * BBodyGetNbScratch(that));
+  BBodyGetVal(
+    that,
+    u->_val,
+    res->_val,
+    scratch);
+
   // Free memory
-  VecFree(&weights);
+  free(scratch);
 
   // Return the result
   return res;
 
 }
 
+// Get the value of the BBody 'that' at parameter 'u' (array of as many
+// floats as inputs) and store it in 'res' (array of as many floats as
+// outputs)
+// The control points are contracted one input at a time with the 
+// weights of this input, using 'scratch' (array of at least 
+// BBodyGetNbScratch(that) floats allocated by the user) as working 
+// memory
+// No memory allocation occurs
+void BBodyGetVal(const BBody* const that, const float* const u, 
+  float* const res, float* const scratch) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (u == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'u' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (scratch == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'scratch' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  int order = that->_order;
+  int nbCtrlInp = order + 1;
+  int nbInputs = VecGet(&(that->_dim), 0);
+  int nbDimOut = VecGet(&(that->_dim), 1);
+  // Get the weights of the control points per input
+  float* w = scratch;
+  for (int iInp = nbInputs; iInp--;)
+    _BCurveGetWeightOrderN(order, u[iInp], w + iInp * nbCtrlInp);
+  // Contract the control points along the last input, the last input
+  // being the one varying the fastest in the control points
+  float* grid = scratch + nbInputs * nbCtrlInp;
+  const float* wLast = w + (nbInputs - 1) * nbCtrlInp;
+  int nbGrid = 1;
+  for (int iInp = nbInputs - 1; iInp--;)
+    nbGrid *= nbCtrlInp;
+  for (int iGrid = nbGrid; iGrid--;) {
+    VecFloat* const* ctrl = that->_ctrl + iGrid * nbCtrlInp;
+    float* val = grid + iGrid * nbDimOut;
+    const float* src = ctrl[0]->_val;
+    for (int iDim = nbDimOut; iDim--;)
+      val[iDim] = wLast[0] * src[iDim];
+    for (int k = 1; k < nbCtrlInp; ++k) {
+      src = ctrl[k]->_val;
+      for (int iDim = nbDimOut; iDim--;)
+        val[iDim] += wLast[k] * src[iDim];
+    }
+  }
+  // Contract in place the grid along the other inputs, from the last 
+  // to the first one, the 'iGrid'-th result only depends on values at
+  // positions greater or equal to 'iGrid' and its first term is the 
+  // only one overlapping it
+  for (int iInp = nbInputs - 1; iInp--;) {
+    const float* wInp = w + iInp * nbCtrlInp;
+    nbGrid /= nbCtrlInp;
+    for (int iGrid = 0; iGrid < nbGrid; ++iGrid) {
+      float* val = grid + iGrid * nbDimOut;
+      const float* src = grid + iGrid * nbCtrlInp * nbDimOut;
+      for (int iDim = nbDimOut; iDim--;)
+        val[iDim] = wInp[0] * src[iDim];
+      for (int k = 1; k < nbCtrlInp; ++k) {
+        src += nbDimOut;
+        for (int iDim = nbDimOut; iDim--;)
+          val[iDim] += wInp[k] * src[iDim];
+      }
+    }
+  }
+  // Copy the result
+  memcpy(res, grid, sizeof(float) * nbDimOut);
+}
+
+// Get the values of the BBody 'that' on the grid of parameters whose 
+// values for the 'iInp'-th input are the 'nbSample'['iInp'] floats 
+// 'u'['iInp'] and store them in 'res', allocated by the user with 
+// (product of 'nbSample') * (output dimension) floats
+// The values are stored one after the other, the last input varying 
+// the fastest
+// The weights of each input are calculated once per sample, and the 
+// control points are contracted one input at a time, for a cost of
+// O(size of the grid * (order + 1)) per output dimension
+// If 'that' has 2 inputs and 'tri' is not null, the indices in 'res' 
+// of the vertices of the triangles covering the grid are stored in 
+// 'tri', allocated by the user with at least 
+// 6 * ('nbSample'[0] - 1) * ('nbSample'[1] - 1) ints
+void BBodyGetGrid(const BBody* const that, const int* const nbSample,
+  const float* const* const u, float* const res, int* const tri) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (nbSample == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'nbSample' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (u == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'u' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+  for (int iInp = VecGet(&(that->_dim), 0); iInp--;) {
+    if (nbSample[iInp] < 1) {
+      BCurveErr->_type = PBErrTypeInvalidArg;
+      sprintf(BCurveErr->_msg, "'nbSample'[%d] is invalid (%d>0)", 
+        iInp, nbSample[iInp]);
+      PBErrCatch(BCurveErr);
+    }
+  }
+#endif
+  int nbCtrlInp = that->_order + 1;
+  int nbInputs = VecGet(&(that->_dim), 0);
+  int nbDimOut = VecGet(&(that->_dim), 1);
+  // Get the table of weights of each input, and the size of the 
+  // largest intermediate tensor of the contractions (the result of the
+  // last one being stored directly in 'res', it's not included)
+  float* w[nbInputs];
+  long nbOuter = 1;
+  long nbInner = BBodyGetNbCtrl(that) * nbDimOut;
+  long size = nbInner;
+  for (int iInp = 0; iInp < nbInputs; ++iInp) {
+    w[iInp] = PBErrMalloc(BCurveErr, 
+      sizeof(float) * nbSample[iInp] * nbCtrlInp);
+    for (int iSample = nbSample[iInp]; iSample--;)
+      _BCurveGetWeightOrderN(that->_order, u[iInp][iSample], 
+        w[iInp] + iSample * nbCtrlInp);
+    nbInner /= nbCtrlInp;
+    nbOuter *= nbSample[iInp];
+    if (iInp < nbInputs - 1)
+      size = MAX(size, nbOuter * nbInner);
+  }
+  // Copy the control points in the first intermediate tensor, the 
+  // contractions alternating between two buffers
+  float* buffer[2];
+  buffer[0] = PBErrMalloc(BCurveErr, sizeof(float) * size);
+  buffer[1] = PBErrMalloc(BCurveErr, sizeof(float) * size);
+  for (int iCtrl = BBodyGetNbCtrl(that); iCtrl--;)
+    memcpy(buffer[0] + iCtrl * nbDimOut, that->_ctrl[iCtrl]->_val, 
+      sizeof(float) * nbDimOut);
+  // Contract the tensor along each input, from the first one, the last
+  // contraction being stored directly in 'res'
+  nbOuter = 1;
+  nbInner = BBodyGetNbCtrl(that) * nbDimOut;
+  for (int iInp = 0; iInp < nbInputs; ++iInp) {
+    nbInner /= nbCtrlInp;
+    _BBodyContract(buffer[iInp % 2], nbOuter, nbCtrlInp, nbInner, 
+      w[iInp], nbSample[iInp], 
+      (iInp == nbInputs - 1 ? res : buffer[(iInp + 1) % 2]));
+    nbOuter *= nbSample[iInp];
+  }
+  // If the user requested the triangles
+  if (tri != NULL && nbInputs == 2) {
+    int* t = tri;
+    for (int i0 = 0; i0 < nbSample[0] - 1; ++i0) {
+      for (int i1 = 0; i1 < nbSample[1] - 1; ++i1) {
+        int v = i0 * nbSample[1] + i1;
+        *(t++) = v;
+        *(t++) = v + nbSample[1];
+        *(t++) = v + 1;
+        *(t++) = v + 1;
+        *(t++) = v + nbSample[1];
+        *(t++) = v + nbSample[1] + 1;
+      }
+    }
+  }
+  // Free memory
+  free(buffer[0]);
+  free(buffer[1]);
+  for (int iInp = nbInputs; iInp--;)
+    free(w[iInp]);
+}
+
 // Return a clone of the BBody 'that'
 BBody* BBodyClone(const BBody* const that) {
 #if BUILDMODE == 0
@@ -1718,29 +5111,180 @@ Facoid* BBodyGetBoundingBox(const BBody* const that) {
     PBErrCatch(BCurveErr);
   }
 #endif
+  // Get the bounding box of the control points
+  int dim = VecGet(BBodyDim(that), 1);
+  float bound[2 * dim];
+  BBodyGetBound(that, false, bound);
   // Declare a variable to memorize the result
-  Facoid* res = FacoidCreate(VecGet(BBodyDim(that), 1));
+  Facoid* res = FacoidCreate(dim);
   // For each dimension
-  for (int iDim = VecGet(BBodyDim(that), 1); iDim--;) {
-    // Initialise the bounding box in this dimension
-    VecSet(res->_s._pos, iDim, VecGet(that->_ctrl[0], iDim));
-    VecSet(res->_s._axis[iDim], iDim, VecGet(that->_ctrl[0], iDim));
-    // For each control point except the first one
-    for (int iCtrl = BBodyGetNbCtrl(that); iCtrl-- && iCtrl != 0;) {
-      // Update the bounding box
-      if (VecGet(that->_ctrl[iCtrl], iDim) < VecGet(res->_s._pos, iDim))
-        VecSet(res->_s._pos, iDim, VecGet(that->_ctrl[iCtrl], iDim));
-      if (VecGet(that->_ctrl[iCtrl], iDim) > 
-        ShapoidAxisGet(res, iDim, iDim))
-        ShapoidAxisSet(res, iDim, iDim,
-        VecGet(that->_ctrl[iCtrl], iDim));
-    }
-    ShapoidAxisSetAdd(res, iDim, iDim, -1.0 * ShapoidPosGet(res, iDim));
+  for (int iDim = dim; iDim--;) {
+    VecSet(res->_s._pos, iDim, bound[iDim]);
+    VecSet(res->_s._axis[iDim], iDim, bound[dim + iDim] - bound[iDim]);
   }
   // Return the result
   return res;
 }
 
+// Get the tight bounding box of the BBody, calculated by subdivision
+// of the body instead of from its control points, with a tolerance 
+// of BCURVE_BOUNDEPS relative to the bounding box of the control 
+// points
+// Return a Facoid whose axis are aligned on the standard coordinate 
+// system.
+Facoid* BBodyGetTightBoundingBox(const BBody* const that) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  int dim = VecGet(BBodyDim(that), 1);
+  float bound[2 * dim];
+  BBodyGetBound(that, true, bound);
+  return _BCurveBoundToFacoid(bound, dim);
+}
+
+// Get the bounding box of the BBody 'that' and store it in the array
+// 'res' allocated by the user with 2 * _dim[1] floats (minimum values
+// followed by maximum values)
+// If 'tight' is true the bounding box of the body is calculated (cf 
+// BBodyGetTightBoundingBox), else the one of its control points
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
+void BBodyGetBound(const BBody* const that, const bool tight, 
+  float* const res) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (res == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'res' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  int dimIn = VecGet(BBodyDim(that), 0);
+  int dim = VecGet(BBodyDim(that), 1);
+  int nbCtrl = BBodyGetNbCtrl(that);
+  // If the bounding box is in the cache, copy it
+  const float* cache = (tight ? that->_tightBound : that->_bound);
+  if (cache != NULL) {
+    memcpy(res, cache, sizeof(float) * 2 * dim);
+    return;
+  }
+  float val[nbCtrl];
+  float* scratch = NULL;
+  if (tight)
+    scratch = PBErrMalloc(BCurveErr, 
+      sizeof(float) * 2 * BCURVE_BOUNDMAXDEPTH * nbCtrl);
+  // Loop on output dimension
+  for (int iDim = dim; iDim--;) {
+    // Get the range of the control points
+    for (int iCtrl = nbCtrl; iCtrl--;)
+      val[iCtrl] = that->_ctrl[iCtrl]->_val[iDim];
+    float lo = val[0];
+    float hi = val[0];
+    for (int iCtrl = nbCtrl; iCtrl--;) {
+      lo = MIN(lo, val[iCtrl]);
+      hi = MAX(hi, val[iCtrl]);
+    }
+    // If the bounding box is tight, get the range of the body
+    if (tight) {
+      res[iDim] = val[0];
+      res[dim + iDim] = val[0];
+      _BBodyGetBoundScalar(val, that->_order, dimIn, 
+        BCURVE_BOUNDEPS * (hi - lo), 0, res + iDim, res + dim + iDim,
+        scratch);
+    } else {
+      res[iDim] = lo;
+      res[dim + iDim] = hi;
+    }
+  }
+  free(scratch);
+  // Update the cache
+  float* bound = PBErrMalloc(BCurveErr, sizeof(float) * 2 * dim);
+  memcpy(bound, res, sizeof(float) * 2 * dim);
+  if (tight)
+    ((BBody*)that)->_tightBound = bound;
+  else
+    ((BBody*)that)->_bound = bound;
+}
+
+// Update the range ['min','max'] with the range, with a tolerance of 
+// 'tol', of the tensor product Bezier polynomial of order 'order' in 
+// 'dimIn' variables with coefficients 'val', by recursive subdivision
+// at depth 'depth'
+// 'scratch' is an array of at least 2 * BCURVE_BOUNDMAXDEPTH * 
+// (order + 1)^dimIn floats, shared by all the depths of the recursion
+void _BBodyGetBoundScalar(const float* const val, const int order, 
+  const int dimIn, const float tol, const int depth, float* const min,
+  float* const max, float* const scratch) {
+  int nbCtrl = powi(order + 1, dimIn);
+  // Get the range of the coefficients, which contains the range of 
+  // the polynomial
+  float lo = val[0];
+  float hi = val[0];
+  for (int iCtrl = nbCtrl; iCtrl--;) {
+    lo = MIN(lo, val[iCtrl]);
+    hi = MAX(hi, val[iCtrl]);
+  }
+  // At the top of the recursion, search the range from the value at 
+  // one corner and widen it by the tolerance to keep it conservative
+  if (depth == 0) {
+    float rangeMin = val[0];
+    float rangeMax = val[0];
+    _BBodyGetBoundScalar(val, order, dimIn, tol, 1, &rangeMin, 
+      &rangeMax, scratch);
+    *min = MIN(*min, MAX(lo, rangeMin - tol));
+    *max = MAX(*max, MIN(hi, rangeMax + tol));
+    return;
+  }
+  // The coefficients at the corners are values of the polynomial
+  for (int iCorner = (1 << dimIn); iCorner--;) {
+    int iCtrl = 0;
+    for (int iAxis = 0; iAxis < dimIn; ++iAxis)
+      iCtrl = iCtrl * (order + 1) + ((iCorner >> iAxis) & 1) * order;
+    *min = MIN(*min, val[iCtrl]);
+    *max = MAX(*max, val[iCtrl]);
+  }
+  // Stop if this part can't extend the range
+  if (lo >= *min - tol && hi <= *max + tol)
+    return;
+  if (depth >= BCURVE_BOUNDMAXDEPTH) {
+    *min = MIN(*min, lo);
+    *max = MAX(*max, hi);
+    return;
+  }
+  // Split along one axis, with the De Casteljau algorithm on each 
+  // line of coefficients along this axis, and search each half
+  // The halves are stored in the part of the scratch memory of this 
+  // depth, the following parts being used by the deeper levels
+  int stride = powi(order + 1, dimIn - 1 - depth % dimIn);
+  float* left = scratch + 2 * depth * nbCtrl;
+  float* right = left + nbCtrl;
+  for (int iCtrl = 0; iCtrl < nbCtrl; ++iCtrl) {
+    if ((iCtrl / stride) % (order + 1) != 0)
+      continue;
+    float tmp[order + 1];
+    for (int k = order + 1; k--;)
+      tmp[k] = val[iCtrl + k * stride];
+    for (int level = 0; level <= order; ++level) {
+      left[iCtrl + level * stride] = tmp[0];
+      right[iCtrl + (order - level) * stride] = tmp[order - level];
+      for (int k = 0; k < order - level; ++k)
+        tmp[k] = 0.5 * (tmp[k] + tmp[k + 1]);
+    }
+  }
+  _BBodyGetBoundScalar(left, order, dimIn, tol, depth + 1, min, max, 
+    scratch);
+  _BBodyGetBoundScalar(right, order, dimIn, tol, depth + 1, min, max, 
+    scratch);
+}
+
 // Create a new BBody of order 'order' which approximates best, according
 // to least square regression, the point cloud defined by the
 // 'inputs'/'outputs'
@@ -1749,6 +5293,8 @@ Facoid* BBodyGetBoundingBox(const BBody* const that) {
 // If 'bias' is not null, it is set to the average of the biases from
 // the least square regression on each output
 // 'order' must be > 0
+// The whole regression matrix is created in memory, cf BBodyFitter
+// for large point clouds
 BBody* BBodyFromPointCloud(
             const int order,
   const GSetVecFloat* inputs,
@@ -2172,3 +5718,222 @@ VecFloat* BBodyGetWeightCtrlPt(
   return weights;
 
 }
+
+// -------------- BBodyFitter
+
+// ================ Functions implementation ====================
+
+// Create a new BBodyFitter for a BBody of order 'order' and dimensions
+// 'dim' (inputs and outputs)
+// 'order' must be > 0
+BBodyFitter* BBodyFitterCreate(const int order, 
+  const VecShort2D* const dim) {
+#if BUILDMODE == 0
+  if (dim == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'dim' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (order < 1) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "Invalid order (%d>=1)", order);
+    PBErrCatch(BCurveErr);
+  }
+  if (VecGet(dim, 0) < 1 || VecGet(dim, 1) < 1) {
+    BCurveErr->_type = PBErrTypeInvalidArg;
+    sprintf(BCurveErr->_msg, "Invalid dimensions (%d>0, %d>0)", 
+      VecGet(dim, 0), VecGet(dim, 1));
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  // Allocate memory
+  BBodyFitter* that = PBErrMalloc(BCurveErr, sizeof(BBodyFitter));
+  // Set the properties
+  that->_order = order;
+  that->_dim = *dim;
+  int nbInputs = VecGet(dim, 0);
+  int nbDimOut = VecGet(dim, 1);
+  that->_nbCtrl = powi(order + 1, nbInputs);
+  that->_nbPoint = 0;
+  int nbCtrl = that->_nbCtrl;
+  that->_xtx = PBErrMalloc(BCurveErr, sizeof(double) * nbCtrl * nbCtrl);
+  memset(that->_xtx, 0, sizeof(double) * nbCtrl * nbCtrl);
+  that->_xty = PBErrMalloc(BCurveErr, 
+    sizeof(double) * nbCtrl * nbDimOut);
+  memset(that->_xty, 0, sizeof(double) * nbCtrl * nbDimOut);
+  that->_yty = PBErrMalloc(BCurveErr, sizeof(double) * nbDimOut);
+  memset(that->_yty, 0, sizeof(double) * nbDimOut);
+  that->_weight = PBErrMalloc(BCurveErr, sizeof(float) * nbCtrl);
+  that->_weightInp = 
+    PBErrMalloc(BCurveErr, sizeof(float) * nbInputs * (order + 1));
+  // Return the new BBodyFitter
+  return that;
+}
+
+// Free the memory used by the BBodyFitter 'that'
+void BBodyFitterFree(BBodyFitter** that) {
+  // Check argument
+  if (that == NULL || *that == NULL)
+    return;
+  // Free memory
+  free((*that)->_xtx);
+  free((*that)->_xty);
+  free((*that)->_yty);
+  free((*that)->_weight);
+  free((*that)->_weightInp);
+  free(*that);
+  *that = NULL;
+}
+
+// Add the point of inputs 'input' and outputs 'output' (arrays of 
+// floats of the dimensions of the BBodyFitter 'that') to the point 
+// cloud of 'that'
+// 'input' expected in [0.0, 1.0] but may be out of range
+void BBodyFitterAdd(BBodyFitter* const that, const float* const input, 
+  const float* const output) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (input == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'input' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (output == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'output' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  int nbCtrlInp = that->_order + 1;
+  int nbInputs = VecGet(&(that->_dim), 0);
+  int nbDimOut = VecGet(&(that->_dim), 1);
+  int nbCtrl = that->_nbCtrl;
+  // Get the weights of the control points per input
+  float* wInp = that->_weightInp;
+  for (int iInp = nbInputs; iInp--;)
+    _BCurveGetWeightOrderN(that->_order, input[iInp], 
+      wInp + iInp * nbCtrlInp);
+  // Get the weights of the control points, product of the weights per
+  // input, in the same order as the control points of the BBody (the 
+  // last input varying the fastest)
+  float* w = that->_weight;
+  w[0] = 1.0;
+  int nbW = 1;
+  for (int iInp = 0; iInp < nbInputs; ++iInp) {
+    for (int i = nbW; i--;)
+      for (int k = nbCtrlInp; k--;)
+        w[i * nbCtrlInp + k] = w[i] * wInp[iInp * nbCtrlInp + k];
+    nbW *= nbCtrlInp;
+  }
+  // Accumulate the normal equations
+  for (int i = 0; i < nbCtrl; ++i) {
+    double wi = w[i];
+    if (wi == 0.0)
+      continue;
+    double* row = that->_xtx + i * nbCtrl - i;
+    for (int j = i; j < nbCtrl; ++j)
+      row[j] += wi * w[j];
+    double* xty = that->_xty + i * nbDimOut;
+    for (int iDim = nbDimOut; iDim--;)
+      xty[iDim] += wi * output[iDim];
+  }
+  for (int iDim = nbDimOut; iDim--;)
+    that->_yty[iDim] += (double)output[iDim] * (double)output[iDim];
+  ++(that->_nbPoint);
+}
+
+// Add the 'nbPoint' points of inputs 'inputs' and outputs 'outputs' 
+// (arrays of 'nbPoint' times the dimensions of the BBodyFitter 'that'
+// floats, stored point after point) to the point cloud of 'that'
+void BBodyFitterAddChunk(BBodyFitter* const that, const long nbPoint,
+  const float* const inputs, const float* const outputs) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (inputs == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'inputs' is null");
+    PBErrCatch(BCurveErr);
+  }
+  if (outputs == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'outputs' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  int nbInputs = VecGet(&(that->_dim), 0);
+  int nbDimOut = VecGet(&(that->_dim), 1);
+  // Add the points one by one
+  for (long iPoint = 0; iPoint < nbPoint; ++iPoint)
+    BBodyFitterAdd(that, inputs + iPoint * nbInputs, 
+      outputs + iPoint * nbDimOut);
+}
+
+// Create a new BBody which approximates best, according to least 
+// square regression, the points added so far to the BBodyFitter 'that'
+// More points can be added to 'that' afterward
+// Return NULL if it couldn't find the BBody (the regression failed)
+// If 'bias' is not null, it is set to the average over the outputs of
+// the norm of the residuals of the regression, as in 
+// BBodyFromPointCloud
+BBody* BBodyFitterSolve(const BBodyFitter* const that, 
+  float* const bias) {
+#if BUILDMODE == 0
+  if (that == NULL) {
+    BCurveErr->_type = PBErrTypeNullPointer;
+    sprintf(BCurveErr->_msg, "'that' is null");
+    PBErrCatch(BCurveErr);
+  }
+#endif
+  int nbCtrl = that->_nbCtrl;
+  int nbDimOut = VecGet(&(that->_dim), 1);
+  // Solve the normal equations on a copy to keep the accumulated ones
+  double* xtx = PBErrMalloc(BCurveErr, sizeof(double) * nbCtrl * nbCtrl);
+  memcpy(xtx, that->_xtx, sizeof(double) * nbCtrl * nbCtrl);
+  double* beta = PBErrMalloc(BCurveErr, 
+    sizeof(double) * nbCtrl * nbDimOut);
+  memcpy(beta, that->_xty, sizeof(double) * nbCtrl * nbDimOut);
+  bool ret = _BCurveSolveBandSys(xtx, nbCtrl, nbCtrl - 1, beta, 
+    nbDimOut);
+  BBody* res = NULL;
+  // If the regression has a solution
+  if (ret == true) {
+    // Create the BBody and set its control points
+    res = BBodyCreate(that->_order, &(that->_dim));
+    for (int iCtrl = nbCtrl; iCtrl--;)
+      for (int iDim = nbDimOut; iDim--;)
+        res->_ctrl[iCtrl]->_val[iDim] = beta[iCtrl * nbDimOut + iDim];
+    // If the user requested the bias
+    if (bias != NULL) {
+      // Get the norm of the residuals per output from the normal 
+      // equations: |Y - X.beta|^2 = Y^t.Y - 2.beta^t.X^t.Y + 
+      // beta^t.X^t.X.beta
+      *bias = 0.0;
+      for (int iDim = nbDimOut; iDim--;) {
+        double r = that->_yty[iDim];
+        for (int i = nbCtrl; i--;) {
+          double bi = beta[i * nbDimOut + iDim];
+          r -= 2.0 * bi * that->_xty[i * nbDimOut + iDim];
+          const double* row = that->_xtx + i * nbCtrl - i;
+          r += bi * bi * row[i];
+          for (int j = i + 1; j < nbCtrl; ++j)
+            r += 2.0 * bi * row[j] * beta[j * nbDimOut + iDim];
+        }
+        *bias += sqrt(MAX(0.0, r));
+      }
+      *bias /= (float)nbDimOut;
+    }
+  }
+  // Free memory
+  free(xtx);
+  free(beta);
+  // Return the result
+  return res;
+}
@@ -10,6 +10,8 @@
 #include <math.h>
 #include <string.h>
 #include <stdbool.h>
+#include <pthread.h>
+#include <unistd.h>
 #include "pberr.h"
 #include "pbmath.h"
 #include "gset.h"
@@ -17,10 +19,90 @@
 
 // ================= Define ==================
 
+// Number of parameters evaluated in parallel by the vectorized 
+// evaluation kernels
+#define BCURVE_NBLANE 16
+
+// Number of points between two exact calculations of the differences
+// in the forward differencing tessellation
+#define BCURVE_FDANCHOR 64
+
+// Number of intervals per segment in the arc length table of a SCurve
+#define BCURVE_NBARCLENSUB 8
+
+// Maximum depth of subdivision in the adaptive tessellation
+#define BCURVE_ADAPTIVEMAXDEPTH 16
+
+// Default number of samples in SCurveGetDistToCurve and number of 
+// samples evaluated at once
+#define BCURVE_DISTNBSAMPLE 100
+#define BCURVE_DISTNBBLOCK 64
+
+// Number of rows and columns of the tiles of the matrix of distances
+// computed by one thread at once
+#define BCURVE_DISTTILE 32
+
+// Maximum number of segments in a leaf of the bounding volume 
+// hierarchy of a SCurve and maximum depth of its traversal stack
+#define BCURVE_BVHLEAFSIZE 4
+#define BCURVE_BVHSTACK 64
+
+// Number of intervals of the coarse sampling seeding the Newton 
+// iterations, and maximum number of Newton iterations, in the 
+// projection of points on a SCurve
+#define BCURVE_CLOSESTNBSAMPLE 8
+#define BCURVE_CLOSESTNBITER 8
+
+// Size of the parameter intervals at which the subdivision stops in 
+// the intersection of SCurves, distance in parameter under which two 
+// intersections are considered the same, maximum depth of the search
+// for the self-intersections of one segment and size of the stack of
+// the traversal of pairs of nodes of the SCurveBVHs
+#define BCURVE_INTERSECTEPS 0.00001
+#define BCURVE_INTERSECTDUP 0.001
+#define BCURVE_INTERSECTSELFDEPTH 8
+#define BCURVE_INTERSECTSTACK 256
+
+// Tolerance, relative to the extent of the control points, and 
+// maximum depth of the subdivision calculating the tight bounding 
+// boxes of BBody and of BCurve of order greater than 3
+#define BCURVE_BOUNDEPS 0.0001
+#define BCURVE_BOUNDMAXDEPTH 32
+
+// Threshold on the pivot, relative to the largest absolute value of 
+// the matrix (of its diagonal for definite positive matrices), under 
+// which a linear system is considered singular, so it doesn't depend 
+// on the scale of the data
+#define BCURVE_LINSYSEPS 1e-12
+
+// Weight, relative to the number of points per unknown control point,
+// of the penalty on the distance between consecutive control points
+// in the least squares fitting of control points
+#define BCURVE_FITSMOOTH 1e-6
+
+// Attribute compiling the vectorized evaluation kernels for several 
+// instruction sets (AVX-512, AVX2 and SSE2 as default on x86_64), the 
+// best one being selected once at startup according to the CPU
+// On other platforms the kernels are compiled once for the target
+#if defined(__GNUC__) && !defined(__clang__) && \
+  defined(__x86_64__) && defined(__linux__) && \
+  !defined(BCURVE_NOSIMDDISPATCH)
+  #define BCURVE_SIMDDISPATCH \
+    __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+  #define BCURVE_SIMDDISPATCH
+#endif
+
 // -------------- BCurve
 
 // ================= Data structure ===================
 
+// Type of the functions receiving the points of a tessellation one 
+// after the other, 'point' is an array of _dim floats and 'data' is 
+// the user data given to the tessellation function
+typedef void (*BCurvePointFun)(const float* const point, 
+  void* const data);
+
 typedef struct BCurve {
   // Order
   const int _order;
@@ -29,6 +111,25 @@ typedef struct BCurve {
   // array of (_order + 1) control points (vectors of dimension _dim)
   // defining the curve
   VecFloat** _ctrl;
+  // Flag to memorize if the control points are stored one after the 
+  // other at a constant stride in a block of memory the BCurve doesn't
+  // own one by one: the block of the BCurve itself (cf 
+  // BCurveCreatePacked) or the block of control points of the SCurve 
+  // the BCurve is a segment of
+  bool _packed;
+  // Flag to memorize if the BCurve is evaluated with its coefficients 
+  // in power basis (cf BCurveSetUsePowerBasis)
+  bool _usePowerBasis;
+  // Cache for the coefficients in power basis, (_order + 1) values 
+  // per dimension, from the constant to the highest degree
+  // NULL if they haven't been calculated yet or have been invalidated
+  float* _powerBasis;
+  // Cached bounding boxes of the control points and tight bounding 
+  // box (cf BCurveGetBound), and cached center
+  // NULL if they haven't been calculated yet or have been invalidated
+  float* _bound;
+  float* _tightBound;
+  VecFloat* _center;
 } BCurve;
 
 // ================ Functions declaration ====================
@@ -36,6 +137,13 @@ typedef struct BCurve {
 // Create a new BCurve of order 'order' and dimension 'dim'
 BCurve* BCurveCreate(const int order, const int dim);
 
+// Create a new BCurve of order 'order' and dimension 'dim' whose 
+// array of control points and control points are allocated in one 
+// single block of memory together with the BCurve
+// The control points are stored one after the other at a constant 
+// stride, and are still accessible as VecFloat 
+BCurve* BCurveCreatePacked(const int order, const int dim);
+
 // Clone the BCurve
 BCurve* BCurveClone(const BCurve* const that);
 
@@ -99,12 +207,235 @@ float BCurveCtrlGet(const BCurve* const that, const int iCtrl,
 // u can extend beyond [0.0, 1.0]
 VecFloat* BCurveGet(const BCurve* const that, const float u);
 
+// Get the values of the BCurve at the 'nbU' paramaters 'u' and 
+// store them in the array 'res' allocated by the user with at least 
+// 'nbU' * _dim floats
+// If 'soa' is false the values are stored point by point 
+// (res[iU * _dim + iDim]), else they are stored dimension by dimension
+// (res[iDim * nbU + iU])
+// u can extend beyond [0.0, 1.0]
+// No memory allocation occurs
+void BCurveGetBatch(const BCurve* const that, const long nbU, 
+  const float* const u, float* const res, const bool soa);
+
+// Get the derivative of the BCurve 'that' at parameter 'u' and store
+// it in the array 'res' allocated by the user with at least _dim floats
+// u can extend beyond [0.0, 1.0]
+// No memory allocation occurs
+void BCurveGetDerivative(const BCurve* const that, const float u, 
+  float* const res);
+
+// Vectorized kernel of the De Casteljau algorithm in one dimension 
+// for a BCurve of order 'order' whose control points' values in that 
+// dimension are 'ctrl'
+// Evaluate 'nbBlock' blocks of BCURVE_NBLANE parameters 'u' in 
+// parallel and store the results in 'res' with a stride of 'stride'
+void _BCurveGetBatchKernel(const float* const ctrl, const int order, 
+  const long nbBlock, const float* const u, float* const res, 
+  const long stride);
+
+// Set the weights 'w' of the control points of a BCurve of order 1
+// at parameter 't'
+// 'w' must be allocated by the user with at least 2 floats
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetWeightOrder1(const float t, float* const w);
+
+// Set the weights 'w' of the control points of a BCurve of order 2
+// at parameter 't'
+// 'w' must be allocated by the user with at least 3 floats
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetWeightOrder2(const float t, float* const w);
+
+// Set the weights 'w' of the control points of a BCurve of order 3
+// at parameter 't'
+// 'w' must be allocated by the user with at least 4 floats
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetWeightOrder3(const float t, float* const w);
+
+// Set the weights 'w' of the control points of a BCurve of order 
+// 'order' at parameter 't' with the generic recurrence
+// 'w' must be allocated by the user with at least 'order' + 1 floats
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetWeightOrderN(const int order, const float t, 
+  float* const w);
+
+// Get the value of the BCurve 'that' of order 1 and dimension 2 at 
+// parameter 'u' and store it in 'res' with a stride of 'stride'
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetOrder1Dim2(const BCurve* const that, const float u, 
+  float* const res, const long stride);
+
+// Get the value of the BCurve 'that' of order 1 and dimension 3 at 
+// parameter 'u' and store it in 'res' with a stride of 'stride'
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetOrder1Dim3(const BCurve* const that, const float u, 
+  float* const res, const long stride);
+
+// Get the value of the BCurve 'that' of order 2 and dimension 2 at 
+// parameter 'u' and store it in 'res' with a stride of 'stride'
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetOrder2Dim2(const BCurve* const that, const float u, 
+  float* const res, const long stride);
+
+// Get the value of the BCurve 'that' of order 2 and dimension 3 at 
+// parameter 'u' and store it in 'res' with a stride of 'stride'
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetOrder2Dim3(const BCurve* const that, const float u, 
+  float* const res, const long stride);
+
+// Get the value of the BCurve 'that' of order 3 and dimension 2 at 
+// parameter 'u' and store it in 'res' with a stride of 'stride'
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetOrder3Dim2(const BCurve* const that, const float u, 
+  float* const res, const long stride);
+
+// Get the value of the BCurve 'that' of order 3 and dimension 3 at 
+// parameter 'u' and store it in 'res' with a stride of 'stride'
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetOrder3Dim3(const BCurve* const that, const float u, 
+  float* const res, const long stride);
+
+// Get the value of the BCurve 'that' at parameter 'u' with the 
+// unrolled evaluation specialized for its order and dimension and 
+// store it in 'res' with a stride of 'stride'
+// Return true if there is such a specialization (order 1, 2 or 3 
+// and dimension 2 or 3), false else (and 'res' is left unchanged)
+#if BUILDMODE != 0
+static inline
+#endif 
+bool _BCurveGetSpecialized(const BCurve* const that, const float u, 
+  float* const res, const long stride);
+
 // Get the order of the BCurve
 #if BUILDMODE != 0
 static inline
 #endif 
 int BCurveGetOrder(const BCurve* const that);
 
+// Return true if the control points of the BCurve are packed (cf 
+// BCurveCreatePacked and the segments of SCurve), false else
+#if BUILDMODE != 0
+static inline
+#endif 
+bool BCurveIsPacked(const BCurve* const that);
+
+// Return true if the control points of the BCurve 'that' are stored 
+// one after the other at a constant stride, false else
+bool _BCurveIsStrided(const BCurve* const that);
+
+// Set the flag memorizing if the BCurve 'that' is evaluated with its 
+// coefficients in power basis to 'flag'
+// The coefficients are calculated at the first evaluation and kept 
+// until the control points are modified, evaluation is then done with 
+// the Horner scheme in O(order) instead of O(order^2). The conversion 
+// to power basis loses precision as the order increases, hence it is 
+// disabled by default
+// Not thread-safe once the flag is set: the first evaluation after a
+// modification of 'that' fills the coefficients through the const 
+// pointer
+#if BUILDMODE != 0
+static inline
+#endif 
+void BCurveSetUsePowerBasis(BCurve* const that, const bool flag);
+
+// Return the flag memorizing if the BCurve 'that' is evaluated with 
+// its coefficients in power basis
+#if BUILDMODE != 0
+static inline
+#endif 
+bool BCurveGetUsePowerBasis(const BCurve* const that);
+
+// Invalidate the data cached by the BCurve 'that'
+// Must be called each time the control points are modified
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveInvalidateCache(BCurve* const that);
+
+// Calculate the coefficients in power basis of the BCurve 'that' 
+// and cache them
+void _BCurveUpdatePowerBasis(const BCurve* const that);
+
+// Calculate the coefficients in power basis of the BCurve 'that' 
+// and store them in 'coeff' allocated by the user with at least 
+// (_order + 1) * _dim doubles, (_order + 1) values per dimension, from 
+// the constant to the highest degree
+void _BCurveGetPowerBasis(const BCurve* const that, 
+  double* const coeff);
+
+// Get the values of the BCurve 'that' at the 'nbPoint' parameters 
+// u0 + i * step, i in [0, nbPoint - 1], and store them point by 
+// point in the array 'res' allocated by the user with at least 
+// 'nbPoint' * _dim floats
+// The values are calculated by forward differencing, the differences 
+// being calculated again exactly every BCURVE_FDANCHOR points and for 
+// the last point to bound the drift
+// No memory allocation occurs
+void BCurveTessellateStep(const BCurve* const that, const float u0, 
+  const float step, const long nbPoint, float* const res);
+
+// Get the values of the BCurve 'that' at 'nbPoint' parameters 
+// uniformly distributed over [0.0, 1.0] (both included) and store 
+// them point by point in the array 'res' allocated by the user with 
+// at least 'nbPoint' * _dim floats
+// 'nbPoint' must be at least 2
+// No memory allocation occurs
+void BCurveTessellate(const BCurve* const that, const long nbPoint, 
+  float* const res);
+
+// Tessellate the BCurve 'that' into a polyline whose distance to the 
+// curve is less than 'tol', and store its points point by point in 
+// the array 'res' allocated by the user with at least 'nbMax' * _dim 
+// floats
+// The BCurve is subdivided recursively (De Casteljau algorithm at 0.5)
+// until the control points of each part are at most at distance 'tol'
+// from the chord of the part, or the depth of subdivision reaches 
+// BCURVE_ADAPTIVEMAXDEPTH
+// Return the number of points of the polyline, if it's greater than 
+// 'nbMax' only the first 'nbMax' points are stored
+// No memory allocation occurs
+long BCurveTessellateAdaptive(const BCurve* const that, const float tol,
+  float* const res, const long nbMax);
+
+// Tessellate the BCurve 'that' as BCurveTessellateAdaptive and give 
+// the points one after the other to the function 'fun' with the user 
+// data 'data'
+// Return the number of points of the polyline
+// No memory allocation occurs
+long BCurveTessellateAdaptiveFun(const BCurve* const that, 
+  const float tol, BCurvePointFun fun, void* const data);
+
+// Tessellate the control points 'ctrl' of a BCurve of order 'order' 
+// and dimension 'dim' (cf BCurveTessellateAdaptive), skipping its first
+// point if 'skipFirst' is true
+// The points are stored in 'res' up to 'nbMax' points if 'res' is not 
+// null, and given to 'fun' with 'data' if 'fun' is not null
+// Return the number of points of the polyline
+long _BCurveTessellateAdaptive(const float* const ctrl, const int order, 
+  const int dim, const float tol, const bool skipFirst, 
+  float* const res, const long nbMax, BCurvePointFun fun, 
+  void* const data);
+
 // Get the dimension of the BCurve
 #if BUILDMODE != 0
 static inline
@@ -119,6 +450,8 @@ static inline
 float BCurveGetApproxLen(const BCurve* const that);
 
 // Return the center of the BCurve (average of control points)
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
 #if BUILDMODE != 0
 static inline
 #endif 
@@ -204,6 +537,78 @@ void _BCurveTranslate(BCurve* const that, const VecFloat* const v);
 // Return NULL if it couldn't create the BCurve
 BCurve* BCurveFromCloudPoint(const GSetVecFloat* const set);
 
+// Solve the linear system 'mat'.x = 'rhs' of 'nb' equations for
+// 'nbRhs' right hand sides at once by Gaussian elimination with partial
+// pivoting, so the matrix is factorized only once
+// 'mat' is a 'nb' x 'nb' matrix and 'rhs' a 'nb' x 'nbRhs' matrix, 
+// both stored by rows. They are modified, and the solutions are stored
+// in 'rhs' on return
+// Return false if the system is singular (cf BCURVE_LINSYSEPS)
+bool _BCurveSolveLinSys(double* const mat, const int nb, 
+  double* const rhs, const int nbRhs);
+
+// Solve the linear system 'mat'.x = 'rhs' of 'nb' equations for
+// 'nbRhs' right hand sides at once, where 'mat' is a symmetric 
+// definite positive band matrix of half width 'hw', by Cholesky 
+// factorization in O('nb' * 'hw'^2)
+// 'band' is the upper band of 'mat', 'band'[i * ('hw' + 1) + j] is 
+// 'mat'[i][i + j], 'rhs' is a 'nb' x 'nbRhs' matrix stored by rows. 
+// They are modified, and the solutions are stored in 'rhs' on return
+// Return false if the matrix is not definite positive (cf 
+// BCURVE_LINSYSEPS)
+bool _BCurveSolveBandSys(double* const band, const int nb, 
+  const int hw, double* const rhs, const int nbRhs);
+
+// Create a BCurve of order 'order' approximating the points given in
+// the GSet 'set'
+// The GSet must contains VecFloat of same dimensions
+// The BCurve starts at the first point and ends at the last point of
+// 'set', the other control points are calculated by least squares 
+// with the points parameterized by their relative distance on the 
+// polyline linking them, as in BCurveFromCloudPoint
+// The cost is linear in the number of points
+// Return NULL if it couldn't create the BCurve
+BCurve* BCurveFromCloudPointOrder(const GSetVecFloat* const set, 
+  const int order);
+
+// Calculate by least squares the control points 'ctrl' of 'nbSeg' 
+// consecutive Bezier curves of order 'order' approximating the 
+// 'nbPoint' points 'points' (of same dimension as 'ctrl')
+// 'ctrl' is the array of the 'nbSeg' * 'order' + 1 control points, 
+// the last control point of a segment being the first one of the next
+// segment
+// If 't' is not null it gives the parameters of the points in [0,1], 
+// in increasing order, else the points are parameterized by their 
+// relative distance on the polyline linking them. The parameters are
+// split uniformly between the segments
+// The first and last control points are set to the first and last 
+// points. A small penalty on the distance between consecutive control
+// points, weighted by BCURVE_FITSMOOTH, keeps the system solvable when
+// some segments have too few points
+// The normal equations are accumulated in O(nbPoint * order^2) and 
+// solved in O(nbSeg * order^3) thanks to their band structure
+// Return false if the system couldn't be solved, in which case 'ctrl'
+// is left unchanged
+bool _BCurveFitCtrl(const VecFloat* const* const points, 
+  const long nbPoint, const float* const t, const int order, 
+  const int nbSeg, VecFloat** const ctrl);
+
+// Add to the normal equations of the least squares fitting of 
+// control points (cf _BCurveFitCtrl) the equation 
+// sum_k('coeff'[k].C['first' + k]) = 'target', where C are the 
+// control points of dimension 'dim', the first one being fixed to
+// 'head' and the last one ('nb' + 1) being fixed to 'tail'
+// 'band' is the upper band of half width 'hw' of the matrix and 'rhs'
+// the right hand sides, one row per unknown control point
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveFitAccumulate(double* const band, double* const rhs, 
+  const int hw, const int nb, const int dim, const int first, 
+  const int nbCoeff, const float* const coeff, 
+  const float* const target, const float* const head, 
+  const float* const tail);
+
 // Get a VecFloat of dimension equal to the number of control points
 // Values of the VecFloat are the weight of each control point in the 
 // BCurve given the curve's order and the value of 't' (in [0.0,1.0])
@@ -214,6 +619,52 @@ VecFloat* BCurveGetWeightCtrlPt(const BCurve* const that, const float t);
 // system.
 Facoid* BCurveGetBoundingBox(const BCurve* const that);
 
+// Get the tight bounding box of the BCurve, calculated from the 
+// extrema of the curve instead of its control points
+// Return a Facoid whose axis are aligned on the standard coordinate 
+// system.
+Facoid* BCurveGetTightBoundingBox(const BCurve* const that);
+
+// Get the bounding box of the BCurve 'that' and store it in the array
+// 'res' allocated by the user with 2 * _dim floats (minimum values 
+// followed by maximum values)
+// If 'tight' is true the bounding box of the curve is calculated, 
+// else the one of its control points
+// The bounding box is cached until the BCurve is modified
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
+void BCurveGetBound(const BCurve* const that, const bool tight, 
+  float* const res);
+
+// Get the bounding box of the Bezier curve of order 'order' and 
+// dimension 'dim' with control points 'ctrl' and store it in the 
+// array 'res' (cf BCurveGetBound)
+void _BCurveGetBoundCtrl(VecFloat* const* const ctrl, const int order,
+  const int dim, const bool tight, float* const res);
+
+// Update the range ['min','max'] with the range of the Bezier 
+// polynomial of order 'order' and coefficients 'val', from the roots
+// of its derivative (in closed form up to order 3, by subdivision 
+// above), widened by BCURVE_BOUNDEPS relative to the range of the 
+// coefficients to stay conservative despite the rounding errors
+void _BCurveGetBoundScalar(const float* const val, const int order, 
+  float* const min, float* const max);
+
+// Update the range ['min','max'] with the range, with a tolerance of 
+// 'tol', of the tensor product Bezier polynomial of order 'order' in 
+// 'dimIn' variables with coefficients 'val', by recursive subdivision
+// at depth 'depth'
+// 'scratch' is an array of at least 2 * BCURVE_BOUNDMAXDEPTH * 
+// (order + 1)^dimIn floats, shared by all the depths of the recursion
+void _BBodyGetBoundScalar(const float* const val, const int order, 
+  const int dimIn, const float tol, const int depth, float* const min,
+  float* const max, float* const scratch);
+
+// Create a Facoid whose axis are aligned on the standard coordinate 
+// system from the bounding box 'bound' of dimension 'dim' (minimum 
+// values followed by maximum values)
+Facoid* _BCurveBoundToFacoid(const float* const bound, const int dim);
+
 // -------------- SCurve
 
 // ================= Data structure ===================
@@ -229,8 +680,62 @@ typedef struct SCurve {
   GSetBCurve _seg;
   // Set of control points
   GSetVecFloat _ctrl;
+  // Block of memory containing all the control points one after the
+  // other, with a stride of _sizeCtrl bytes
+  // The block, _ctrlArr and _segArr are reallocated when a segment is
+  // added and there is no more room for it (cf _SCurveReserve), which
+  // invalidates any pointer to the segments and control points
+  char* _ctrlBlock;
+  size_t _sizeCtrl;
+  // Array of pointers to the control points in _ctrlBlock, the 
+  // 'iCtrl'-th control point is at index (_iHead * _order + iCtrl)
+  VecFloat** _ctrlArr;
+  // Array of segments, views on _ctrlArr sharing their end points, 
+  // the 'iSeg'-th segment is at index (_iHead + iSeg)
+  BCurve* _segArr;
+  // Number of segments which can be stored in _segArr
+  int _capSeg;
+  // Index of the first segment in _segArr
+  int _iHead;
+  // Cached arc length of the SCurve from its start to the parameters 
+  // i / BCURVE_NBARCLENSUB, i in [0, _nbSeg * BCURVE_NBARCLENSUB]
+  // Built when needed, NULL if not up to date
+  float* _arcLen;
+  // Bounding volume hierarchy over the segments (cf SCurveGetBVH)
+  // Built when needed, NULL if not yet built, refitted when needed if
+  // _bvhDirty is true
+  struct SCurveBVH* _bvh;
+  bool _bvhDirty;
+  // Cached bounding boxes of the control points and tight bounding 
+  // box (cf SCurveGetBound), and cached center
+  // NULL if they haven't been calculated yet or have been invalidated
+  float* _bound;
+  float* _tightBound;
+  VecFloat* _center;
 } SCurve;
 
+// Task shared by the threads computing a matrix of distances between
+// SCurves (cf SCurveGetDistMatrix)
+typedef struct SCurveDistMatrixTask {
+  // Descriptors of the SCurves of the rows and columns of the matrix
+  const float* _descA;
+  const float* _descB;
+  // Number of rows and columns of the matrix
+  int _nbA;
+  int _nbB;
+  // Flag to memorize if the matrix is symmetric (rows and columns are 
+  // the same SCurves)
+  bool _sym;
+  // Number of samples and dimension of the descriptors
+  int _nbSample;
+  int _dim;
+  // Matrix of distances
+  float* _res;
+  // Index of the next tile to compute and mutex protecting it
+  long _nextTile;
+  pthread_mutex_t _mutex;
+} SCurveDistMatrixTask;
+
 // ================ Functions declaration ====================
 
 // Create a new SCurve of dimension 'dim', order 'order' and 
@@ -315,6 +820,8 @@ void SCurveCtrlSet(SCurve* const that, const int iCtrl, const int iDim,
   float v);
 
 // Get the 'iCtrl'-th control point
+// The pointer is invalidated by SCurveAddSegHead and SCurveAddSegTail,
+// which may move the segments and control points in memory
 #if BUILDMODE != 0
 static inline
 #endif 
@@ -328,6 +835,8 @@ float SCurveCtrlGet(const SCurve* const that, const int iCtrl,
   const int iDim);
 
 // Get the GSet of control points of the SCurve 'that'
+// The pointers in the GSet and its iterators are invalidated by 
+// SCurveAddSegHead and SCurveAddSegTail
 #if BUILDMODE != 0
 static inline
 #endif 
@@ -340,12 +849,16 @@ static inline
 BCurve* SCurveGetSeg(const SCurve* const that, const int iSeg);
 
 // Get the 'iSeg'-th segment
+// The pointer is invalidated by SCurveAddSegHead and SCurveAddSegTail,
+// which may move the segments and control points in memory
 #if BUILDMODE != 0
 static inline
 #endif 
 const BCurve* SCurveSeg(const SCurve* const that, const int iSeg);
 
 // Get the GSet of segments of the SCurve 'that'
+// The pointers in the GSet and its iterators are invalidated by 
+// SCurveAddSegHead and SCurveAddSegTail
 #if BUILDMODE != 0
 static inline
 #endif 
@@ -354,21 +867,41 @@ const GSetBCurve* SCurveSegs(const SCurve* const that);
 // Add one segment at the end of the curve (controls are set to 
 // vectors null, except the first one which the last one of the current
 // last segment)
+// The segments and control points may be moved in memory, which 
+// invalidates the pointers previously obtained with SCurveSeg, 
+// SCurveCtrl, SCurveSegs, SCurveCtrls and the iterators on the 
+// SCurve or its GSets
 void SCurveAddSegTail(SCurve* const that);
 
 // Add one segment at the head of the curve (controls are set to 
 // vectors null, except the last one which the first one of the current
 // first segment)
+// The segments and control points may be moved in memory, which 
+// invalidates the pointers previously obtained with SCurveSeg, 
+// SCurveCtrl, SCurveSegs, SCurveCtrls and the iterators on the 
+// SCurve or its GSets
 void SCurveAddSegHead(SCurve* const that);
 
 // Remove the fist segment of the curve (which must have more than one
 // segment)
+// The pointers to the removed segment and its control points not 
+// shared with the remaining segments, and the iterators on the 
+// SCurve or its GSets, are invalidated
 void SCurveRemoveHeadSeg(SCurve* const that);
 
 // Remove the last segment of the curve (which must have more than one
 // segment)
+// The pointers to the removed segment and its control points not 
+// shared with the remaining segments, and the iterators on the 
+// SCurve or its GSets, are invalidated
 void SCurveRemoveTailSeg(SCurve* const that);
 
+// Ensure the arrays of segments and control points of the SCurve 'that'
+// have room for at least 'nbHead' more segments at the head and 
+// 'nbTail' more segments at the tail
+void _SCurveReserve(SCurve* const that, const int nbHead, 
+  const int nbTail);
+
 // Get the approximate length of the SCurve (sum of approxLen 
 // of its BCurves)
 #if BUILDMODE != 0
@@ -376,12 +909,72 @@ static inline
 #endif 
 float SCurveGetApproxLen(const SCurve* const that);
 
+// Get the length of the SCurve 'that'
+// The length is calculated by Gauss-Legendre quadrature and cached in
+// the arc length table of the SCurve
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
+float SCurveGetLength(const SCurve* const that);
+
+// Get the length of the SCurve 'that' from its start to the 
+// parameter 'u'
+// u is clipped to [0.0, _nbSeg]
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
+float SCurveGetLengthAtParam(const SCurve* const that, const float u);
+
+// Get the parameter of the SCurve 'that' at which the length from its 
+// start is 'len'
+// The interval containing 'len' is found by binary search in the arc 
+// length table and the parameter is refined by Newton iterations
+// len is clipped to [0.0, SCurveGetLength(that)]
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
+float SCurveGetParamAtLength(const SCurve* const that, const float len);
+
+// Build the arc length table of the SCurve 'that'
+void _SCurveUpdateArcLen(const SCurve* const that);
+
+// Get the length of the 'iSeg'-th segment of the SCurve 'that' between
+// its local parameters 't0' and 't1' by Gauss-Legendre quadrature
+float _SCurveGetSubLength(const SCurve* const that, const int iSeg, 
+  const float t0, const float t1);
+
+// Free the cached data of the SCurve 'that'
+// Must be called each time the control points of the SCurve are 
+// modified
+#if BUILDMODE != 0
+static inline
+#endif 
+void _SCurveInvalidateCache(SCurve* const that);
+
+// Free the cached data of the segments of the SCurve 'that' using 
+// the 'iCtrl'-th control point, or of all the segments if 'iCtrl' is
+// negative
+// Must be called each time the control points of the SCurve are 
+// modified
+#if BUILDMODE != 0
+static inline
+#endif 
+void _SCurveInvalidateSegCache(SCurve* const that, const int iCtrl);
+
 // Return the center of the SCurve (average of control points)
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
 #if BUILDMODE != 0
 static inline
 #endif 
 VecFloat* SCurveGetCenter(const SCurve* const that);
 
+// Get the index of the segment of the SCurve 'that' at paramater 'u'
+// and set 'uloc' to the value of the paramater local to this segment
+// u can extend beyond [0.0, _nbSeg]
+#if BUILDMODE != 0
+static inline
+#endif 
+int SCurveGetSegIndex(const SCurve* const that, const float u, 
+  float* const uloc);
+
 // Get the value of the SCurve at paramater 'u' 
 // The value is equal to the value of the floor(u)-th segment at
 // value (u - floor(u))
@@ -391,6 +984,26 @@ static inline
 #endif 
 VecFloat* SCurveGet(const SCurve* const that, const float u);
 
+// Get the values of the SCurve 'that' at the 'nbU' paramaters 'u' and
+// store them point by point in the array 'res' allocated by the user 
+// with at least 'nbU' * _dim floats
+// The values match those of SCurveGet within the float precision, 
+// the order of the operations being different
+// The segments are walked monotonically if 'u' is sorted in 
+// increasing order, else the parameters are first grouped by segment
+// u can extend beyond [0.0, _nbSeg]
+void SCurveGetBatch(const SCurve* const that, const long nbU, 
+  const float* const u, float* const res);
+
+// Get the values of the SCurve 'that' at the 'nbU' paramaters 'u' 
+// sorted in increasing order and store them point by point in the 
+// array 'res' allocated by the user with at least 'nbU' * _dim floats
+// 'uloc' is an array allocated by the user with at least 'nbU' floats
+// used to memorize the parameters local to the segments
+// No memory allocation occurs
+void _SCurveGetBatchSorted(const SCurve* const that, const long nbU, 
+  const float* const u, float* const uloc, float* const res);
+
 // Return the max value for the parameter 'u' of SCurveGet
 #if BUILDMODE != 0
 static inline
@@ -400,8 +1013,30 @@ float SCurveGetMaxU(const SCurve* const that);
 // Get the bounding box of the SCurve.
 // Return a Facoid whose axis are aligned on the standard coordinate 
 // system.
+// cf SCurveGetTightBoundingBox for the bounding box of the curve 
+// instead of its control points
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer (cf 
+// SCurveGetBound)
 Facoid* SCurveGetBoundingBox(const SCurve* const that);
 
+// Get the tight bounding box of the SCurve, calculated from the 
+// extrema of the curve instead of its control points
+// Return a Facoid whose axis are aligned on the standard coordinate 
+// system.
+Facoid* SCurveGetTightBoundingBox(const SCurve* const that);
+
+// Get the bounding box of the SCurve 'that' and store it in the array
+// 'res' allocated by the user with 2 * _dim floats (minimum values 
+// followed by maximum values)
+// If 'tight' is true the bounding box of the curve is calculated, 
+// else the one of its control points
+// The bounding box is cached until the SCurve is modified
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
+void SCurveGetBound(const SCurve* const that, const bool tight, 
+  float* const res);
+
 // Rotate the curve CCW by 'theta' radians relatively to the origin
 // of the coordinates system
 #if BUILDMODE != 0
@@ -497,13 +1132,111 @@ SCurve* SCurveCreateFromPyramidoid(const Pyramidoid* const shap);
 // Calculate an approximation as there is no exact solution
 SCurve* SCurveCreateFromSpheroid(const Spheroid* const shap);
 
+// Create a new SCurve made of 'nbSeg' segments of order 3 approximating
+// the points given in the GSet 'set'
+// The GSet must contains VecFloat of same dimensions
+// The SCurve starts at the first point and ends at the last point of
+// 'set', the other control points are calculated by least squares 
+// with the points parameterized by their relative distance on the 
+// polyline linking them, split uniformly between the segments
+// The cost is linear in the number of points and segments
+// Return NULL if it couldn't create the SCurve
+SCurve* SCurveCreateFromCloudPoint(const GSetVecFloat* const set, 
+  const int nbSeg);
+
 // Get the distance between the SCurve 'that' and the SCurve 'curve'
 // The distance is defined as the integral of 
 // ||'that'(u(t))-'curve'(v(t))|| where u and v are the relative 
 // positions on the curve over t varying from 0.0 to 1.0
+// The integral is approximated with BCURVE_DISTNBSAMPLE samples
 float SCurveGetDistToCurve(const SCurve* const that, 
   const SCurve* const curve);
 
+// Get the distance between the SCurve 'that' and the SCurve 'curve'
+// (cf SCurveGetDistToCurve) approximated with 'nbSample' samples of t
+// uniformly distributed over [0.0, 1.0[
+// If 'threshold' is greater than 0.0 the calculation stops as soon as
+// the partial integral exceeds 'threshold', and the partial integral is
+// returned
+// No memory allocation occurs
+float SCurveGetDistToCurveSampled(const SCurve* const that, 
+  const SCurve* const curve, const int nbSample, const float threshold);
+
+// Get the descriptor of the SCurve 'that' used to calculate distances 
+// between SCurves, i.e. its values at 'nbSample' relative positions t 
+// uniformly distributed over [0.0, 1.0[ (cf SCurveGetDistToCurve), and
+// store it point by point in the array 'res' allocated by the user 
+// with at least 'nbSample' * _dim floats
+// No memory allocation occurs
+void SCurveGetDistDescriptor(const SCurve* const that, 
+  const int nbSample, float* const res);
+
+// Get the distance between two SCurves from their descriptors 'descA'
+// and 'descB' of 'nbSample' samples in dimension 'dim' 
+// (cf SCurveGetDistDescriptor)
+float SCurveGetDistDescriptors(const float* const descA, 
+  const float* const descB, const int nbSample, const int dim);
+
+// Get the sum of the distances between the 'nb' points of dimension 
+// 'dim' stored point by point in the arrays 'a' and 'b'
+// The points are processed by blocks of BCURVE_NBLANE, with a loop 
+// specialized for the dimensions 2 and 3, and the distances are 
+// accumulated in BCURVE_NBLANE partial sums
+float _SCurveSumDist(const float* const a, const float* const b, 
+  const long nb, const int dim);
+
+// Get the distances (cf SCurveGetDistToCurveSampled) between each 
+// of the 'nbA' SCurves 'curvesA' and each of the 'nbB' SCurves 
+// 'curvesB', approximated with 'nbSample' samples, and store them in 
+// the array 'res' allocated by the user with at least 'nbA' * 'nbB' 
+// floats (res[iA * nbB + iB])
+// If 'curvesB' is null, get the distances between each pair of SCurves
+// in 'curvesA' ('nbB' is ignored and 'res' must have at least 
+// 'nbA' * 'nbA' floats), only half of the matrix is computed and 
+// copied by symmetry
+// All the SCurves must have the same dimension
+// Each SCurve is sampled once into a descriptor, then the matrix is 
+// computed by tiles of BCURVE_DISTTILE x BCURVE_DISTTILE distances 
+// distributed over 'nbThread' threads, or as many threads as cores if 
+// 'nbThread' is less than 1
+void SCurveGetDistMatrix(const SCurve* const* const curvesA, 
+  const int nbA, const SCurve* const* const curvesB, const int nbB, 
+  const int nbSample, const int nbThread, float* const res);
+
+// Function executed by the threads computing a matrix of distances 
+// between SCurves, 'arg' is the SCurveDistMatrixTask shared by the 
+// threads
+void* _SCurveGetDistMatrixThread(void* arg);
+
+// Get the values of the SCurve 'that' at 'nbPoint' parameters 
+// uniformly distributed over [0.0, _nbSeg] (both included) and store 
+// them point by point in the array 'res' allocated by the user with 
+// at least 'nbPoint' * _dim floats
+// 'nbPoint' must be at least 2
+// The values are calculated by forward differencing on each segment
+// (cf BCurveTessellateStep)
+// No memory allocation occurs
+void SCurveTessellate(const SCurve* const that, const long nbPoint, 
+  float* const res);
+
+// Tessellate the SCurve 'that' into a polyline whose distance to the 
+// curve is less than 'tol' (cf BCurveTessellateAdaptive), and store 
+// its points point by point in the array 'res' allocated by the user 
+// with at least 'nbMax' * _dim floats
+// Return the number of points of the polyline, if it's greater than 
+// 'nbMax' only the first 'nbMax' points are stored
+// No memory allocation occurs
+long SCurveTessellateAdaptive(const SCurve* const that, const float tol,
+  float* const res, const long nbMax);
+
+// Tessellate the SCurve 'that' as SCurveTessellateAdaptive and give 
+// the points one after the other to the function 'fun' with the user 
+// data 'data'
+// Return the number of points of the polyline
+// No memory allocation occurs
+long SCurveTessellateAdaptiveFun(const SCurve* const that, 
+  const float tol, BCurvePointFun fun, void* const data);
+
 // Apply the chaikin curve subdivision algorithm to the SCurve 'that'
 // with 'depth' times recursion and 'strength' is the parametric
 // distance from each corner where the curve is cut at each recursion
@@ -524,6 +1257,18 @@ typedef struct SCurveIter {
   float _curPos;
   // Step delta
   float _delta;
+  // Index of the segment at the current position and parameter local
+  // to this segment
+  // Adding or removing segments of the attached SCurve makes them 
+  // stale until the SCurveIter is stepped, or attached again with 
+  // SCurveIterSetCurve
+  int _iSeg;
+  float _uloc;
+  // Flag to step by constant arc length instead of constant parameter
+  bool _byLength;
+  // Current arc length from the start of the attached SCurve, used 
+  // when stepping by arc length
+  float _curLen;
 } SCurveIter;
 
 // ================ Functions declaration ====================
@@ -534,6 +1279,8 @@ SCurveIter SCurveIterCreateStatic(const SCurve* const curve,
   const float delta);
 
 // Set the attached SCurve of the SCurveIter 'that' to 'curve'
+// Must be called again if the number of segments of the attached 
+// SCurve changes
 #if BUILDMODE != 0
 static inline
 #endif 
@@ -558,6 +1305,21 @@ static inline
 #endif 
 float SCurveIterGetDelta(const SCurveIter* const that);
 
+// Set the flag of the SCurveIter 'that' to step by constant arc length
+// to 'byLength'
+// If true, the delta is a length instead of a parameter
+#if BUILDMODE != 0
+static inline
+#endif 
+void SCurveIterSetByLength(SCurveIter* const that, const bool byLength);
+
+// Return true if the SCurveIter 'that' steps by constant arc length, 
+// false else
+#if BUILDMODE != 0
+static inline
+#endif 
+bool SCurveIterIsByLength(const SCurveIter* const that);
+
 // Init the SCurveIter 'that'
 #if BUILDMODE != 0
 static inline
@@ -592,6 +1354,376 @@ static inline
 #endif 
 VecFloat* SCurveIterGet(const SCurveIter* const that);
 
+// Get the current value of the attached SCurve at the current 
+// internal position of the SCurveIter 'that' and store it in the 
+// array 'res' allocated by the user with at least _dim floats
+// No memory allocation occurs
+#if BUILDMODE != 0
+static inline
+#endif 
+void SCurveIterGetVal(const SCurveIter* const that, float* const res);
+
+// Update the segment of the SCurveIter 'that' at its current position
+#if BUILDMODE != 0
+static inline
+#endif 
+void _SCurveIterUpdateSeg(SCurveIter* const that);
+
+// -------------- SCurveBVH
+
+// ================= Data structure ===================
+
+// Bounding volume hierarchy over the segments of a SCurve
+// The node 0 covers all the segments, the node 'iNode' covering more 
+// than BCURVE_BVHLEAFSIZE segments splits them in two halves covered 
+// by the nodes (2 * iNode + 1) and (2 * iNode + 2). As consecutive 
+// segments are spatially close, no sorting is needed to build it
+typedef struct SCurveBVH {
+  // Attached SCurve
+  const SCurve* _curve;
+  // Dimension of the SCurve
+  int _dim;
+  // Number of segments of the SCurve when the SCurveBVH was refitted
+  int _nbSeg;
+  // Number of nodes (including the unused ones)
+  int _nbNode;
+  // Bounding boxes of the nodes and of the segments, as _dim minimum 
+  // values followed by _dim maximum values, the ones of the segments 
+  // being their tight bounding boxes (cf BCurveGetBound)
+  float* _bound;
+  float* _segBound;
+} SCurveBVH;
+
+// Data shared by the recursive subdivisions searching the 
+// intersections between two segments (cf SCurveGetIntersections)
+typedef struct SCurveIntersectTask {
+  // Orders of the two segments
+  int _orderA;
+  int _orderB;
+  // Dimension of the segments
+  int _dim;
+  // Parameters of the start of the two segments in their SCurve
+  float _offA;
+  float _offB;
+  // Candidate intersections, pairs of parameters on each SCurve, 
+  // before their sorting and the removal of duplicates
+  float* _cand;
+  long _nbCand;
+  long _capCand;
+} SCurveIntersectTask;
+
+// ================ Functions declaration ====================
+
+// Create a new SCurveBVH over the segments of the SCurve 'curve'
+SCurveBVH* SCurveBVHCreate(const SCurve* const curve);
+
+// Free the memory used by the SCurveBVH 'that'
+void SCurveBVHFree(SCurveBVH** that);
+
+// Update the bounding boxes of the SCurveBVH 'that' after its 
+// attached SCurve has been modified, in O(number of segments)
+// If the number of segments of the SCurve has changed the nodes are
+// reallocated
+void SCurveBVHRefit(SCurveBVH* const that);
+
+// Get the SCurveBVH attached to the SCurve 'that', build it or refit 
+// it if necessary
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
+const SCurveBVH* SCurveGetBVH(const SCurve* const that);
+
+// Get the parameters of the closest points on the SCurve 'that' of 
+// the 'nbPoint' points 'points' (stored one after the other)
+// The SCurveBVH of 'that' is used to skip the segments which can't 
+// contain the closest point, then on each remaining segment the 
+// parameter is refined by Newton iterations seeded from a coarse 
+// sample
+// If 'warmStart' is true, the search for the 'iPoint'-th point starts
+// from the closest point of the previous one (from the value of 
+// u[0] for the first one, clamped to [0, SCurveGetMaxU], the search 
+// being cold if it's not a finite number), which speeds up the 
+// projection of sequences of close points
+// Store the parameters in the array 'u' and, if 'dist' is not null, 
+// the distances to the SCurve in the array 'dist', both allocated by 
+// the user with at least 'nbPoint' floats
+// No memory allocation occurs, except when the SCurveBVH has to be 
+// built
+// Not thread-safe: it may build the bounding volume hierarchy of 
+// the SCurve(s) (cf SCurveGetBVH)
+void SCurveGetClosestBatch(const SCurve* const that, 
+  const long nbPoint, const float* const points, const bool warmStart,
+  float* const u, float* const dist);
+
+// Get the parameter 't' in [0,1] of the closest point to 'point' on 
+// the segment 'iSeg' of the SCurve 'that' by Newton iterations 
+// seeded from the value of 't' if 'sampleW' is null, else from the 
+// closest of the (BCURVE_CLOSESTNBSAMPLE + 1) samples whose Bernstein
+// weights are given in 'sampleW'
+// Return the square of the distance to the closest point
+float _SCurveGetClosestSeg(const SCurve* const that, const int iSeg,
+  const float* const point, const float* const sampleW, 
+  float* const t);
+
+// Get the intersections between the SCurve 'that' and the SCurve 
+// 'curve' of same dimension, or the self-intersections of 'that' if 
+// 'curve' is null or equal to 'that'
+// Pairs of segments are pruned with the SCurveBVHs of the SCurves, 
+// then the intersections are searched by recursive subdivision of 
+// the segments
+// Return a GSetVecFloat of vectors of 2 values: the parameters of the 
+// intersection on 'that' and on 'curve' (on 'that' for the second 
+// value of self-intersections, which is always greater than the 
+// first one), sorted by increasing first value
+// The curve meeting itself at the same parameter, the end points 
+// shared by consecutive segments are not reported as 
+// self-intersections, nor the ones closer than BCURVE_INTERSECTDUP in
+// parameter
+// Not thread-safe: it may build the bounding volume hierarchy of 
+// the SCurve(s) (cf SCurveGetBVH)
+GSetVecFloat* SCurveGetIntersections(const SCurve* const that, 
+  const SCurve* const curve);
+
+// Search the intersections between the segment of control points 
+// 'ctrlA' on local parameters ['a0','a1'] and the segment of control
+// points 'ctrlB' on local parameters ['b0','b1'], and add them to the 
+// candidates of the SCurveIntersectTask 'task'
+// Return true if at least one intersection has been found
+bool _SCurveIntersectSeg(SCurveIntersectTask* const task, 
+  const float* const ctrlA, const float a0, const float a1,
+  const float* const ctrlB, const float b0, const float b1);
+
+// Search the self-intersections of the segment of control points 
+// 'ctrl' on local parameters ['a0','a1'], at depth 'depth' of the 
+// search, and add them to the candidates of the SCurveIntersectTask 
+// 'task'
+void _SCurveIntersectSelfSeg(SCurveIntersectTask* const task, 
+  const float* const ctrl, const float a0, const float a1, 
+  const int depth);
+
+// Search the intersections between the 'iSeg'-th segment of the 
+// SCurve 'that' and the 'jSeg'-th segment of the SCurve 'curve' and 
+// add them to the candidates of the SCurveIntersectTask 'task'
+void _SCurveIntersectSegPair(const SCurve* const that, const int iSeg,
+  const SCurve* const curve, const int jSeg, 
+  SCurveIntersectTask* const task);
+
+// Add the intersection at parameters 'u' and 'v' to the candidates of
+// the SCurveIntersectTask 'task'
+void _SCurveIntersectAddCand(SCurveIntersectTask* const task, 
+  const float u, const float v);
+
+// Compare the candidate intersections 'a' and 'b' by their first, 
+// then second, parameter (cf qsort)
+int _SCurveIntersectCmp(const void* const a, const void* const b);
+
+// Split the Bezier curve of order 'order' and dimension 'dim' with 
+// control points 'ctrl' (stored one after the other) at its middle 
+// and store the control points of the two halves in 'left' and 
+// 'right'
+void _BCurveSplitCtrl(const float* const ctrl, const int order, 
+  const int dim, float* const left, float* const right);
+
+// Calculate the value 'val', first derivative 'd1' and second 
+// derivative 'd2' (if they are not null) at 't' of the Bezier curve 
+// of order 'order' and dimension 'dim' with control points 'ctrl'
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BCurveGetValDeriv(VecFloat* const* const ctrl, const int order,
+  const int dim, const float t, float* const val, float* const d1, 
+  float* const d2);
+
+// Get the indices of the segments of the SCurveBVH 'that' whose 
+// bounding box intersects the box 'boxMin' 'boxMax'
+// Store in increasing order at most 'nbMax' indices in the array 
+// 'res' allocated by the user, and return the total number of 
+// segments found
+long SCurveBVHQueryBox(const SCurveBVH* const that, 
+  const float* const boxMin, const float* const boxMax, 
+  int* const res, const long nbMax);
+
+// Get the indices of the segments of the SCurveBVH 'that' whose 
+// bounding box is intersected by the ray 'origin' + t * 'dir', 
+// t in [0, 'tMax']
+// Store in increasing order at most 'nbMax' indices in the array 
+// 'res' allocated by the user, and return the total number of 
+// segments found
+long SCurveBVHQueryRay(const SCurveBVH* const that, 
+  const float* const origin, const float* const dir, const float tMax,
+  int* const res, const long nbMax);
+
+// Get the indices of the segments of the SCurveBVH 'that' whose 
+// bounding box is at a distance less or equal than 'radius' 
+// from the point 'center'
+// Store in increasing order at most 'nbMax' indices in the array 
+// 'res' allocated by the user, and return the total number of 
+// segments found
+long SCurveBVHQueryPoint(const SCurveBVH* const that, 
+  const float* const center, const float radius, 
+  int* const res, const long nbMax);
+
+// Get the number of nodes needed to cover the segments 'first' to 
+// 'last' (excluded) with the node 'iNode' and its descendants
+int _SCurveBVHGetNbNode(const int iNode, const int first, 
+  const int last);
+
+// Update the bounding box of the node 'iNode' covering the segments 
+// 'first' to 'last' (excluded) of the SCurveBVH 'that' and of its 
+// descendants
+void _SCurveBVHRefitNode(SCurveBVH* const that, const int iNode, 
+  const int first, const int last);
+
+// Return the square of the distance from the point 'point' to the 
+// bounding box 'bound' of dimension 'dim'
+#if BUILDMODE != 0
+static inline
+#endif 
+float _SCurveBVHGetDist2(const float* const bound, const int dim, 
+  const float* const point);
+
+// Return true if the bounding box 'bound' of dimension 'dim' 
+// satisfies the query of type 'type' (0: box, 1: ray, 2: point) with 
+// arguments 'a', 'b' and 'r' (cf _SCurveBVHQuery)
+#if BUILDMODE != 0
+static inline
+#endif 
+bool _SCurveBVHMatch(const float* const bound, const int dim, 
+  const int type, const float* const a, const float* const b, 
+  const float r);
+
+// Get the indices of the segments of the SCurveBVH 'that' whose 
+// bounding box satisfies the query of type 'type' (0: box, 1: ray, 
+// 2: point) with arguments 'a', 'b' and 'r'
+long _SCurveBVHQuery(const SCurveBVH* const that, const int type,
+  const float* const a, const float* const b, const float r,
+  int* const res, const long nbMax);
+
+// -------------- SCurveFitter
+
+// ================= Data structure ===================
+
+// Incremental fitting of a stream of points with a SCurve of order 3
+// The points of the current window are fitted with one segment, 
+// starting at the first point and ending at the last point of the 
+// window, by least squares on the distance along the polyline of the 
+// window. The window is not stored: the normal equations are built 
+// from moments of the points updated in constant time per point.
+// When the sum of the squared distances between the points and their 
+// fitting exceeds the square of the tolerance (which bounds the 
+// distance of each point), or the window is full, the last valid 
+// fitting is appended to the SCurve and the window restarts from its 
+// last point
+typedef struct SCurveFitter {
+  // Dimension of the points
+  int _dim;
+  // Maximum distance between the points and the fitted curve
+  float _tolerance;
+  // Maximum number of points in the window
+  int _capWindow;
+  // Number of points in the window
+  int _nbPoint;
+  // First and last points of the window
+  VecFloat* _first;
+  VecFloat* _last;
+  // Length of the polyline from the first to the last point of the 
+  // window
+  double _length;
+  // Sums over the points of the window of s^k, k in [2,6], where s is
+  // the length of the polyline from the first point to the point
+  double _moment[5];
+  // Sums over the points of the window of s^k.(P-P0), k in [1,3], 
+  // where P0 is the first point, at index (k-1)*_dim+iDim
+  double* _momentPoint;
+  // Sum over the points of the window of |P-P0|^2
+  double _sqrNorm;
+  // Control points of the fitting of the window, and of the last 
+  // fitting within the tolerance
+  VecFloat* _fit[4];
+  VecFloat* _valid[4];
+  // Number of points fitted by _valid
+  int _nbValid;
+  // SCurve made of the segments emitted since the last call to 
+  // SCurveFitterDrain or SCurveFitterFlush, NULL if there is none
+  SCurve* _curve;
+} SCurveFitter;
+
+// ================ Functions declaration ====================
+
+// Create a new SCurveFitter for points of dimension 'dim', with a 
+// tolerance 'tolerance' on the distance between the points and the 
+// fitted curve and a window of at most 'capWindow' points (at least 
+// 4)
+SCurveFitter* SCurveFitterCreate(const int dim, const float tolerance,
+  const int capWindow);
+
+// Free the memory used by the SCurveFitter 'that' and the SCurve it 
+// contains
+void SCurveFitterFree(SCurveFitter** that);
+
+// Add the point 'point' at the end of the stream fitted by the 
+// SCurveFitter 'that'
+// If the fitting of the window exceeds the tolerance or the window is
+// full, a segment is appended to the SCurve of 'that' with 
+// SCurveAddSegTail
+// The cost per point is constant and nothing is allocated, except 
+// by the emission of a segment. The SCurve of emitted segments grows 
+// with the stream until it is taken by SCurveFitterDrain or 
+// SCurveFitterFlush
+void SCurveFitterAdd(SCurveFitter* const that, 
+  const VecFloat* const point);
+
+// Return the SCurve made of the segments emitted by the SCurveFitter 
+// 'that' since the last call to SCurveFitterDrain or 
+// SCurveFitterFlush, NULL if there is none
+// The user becomes responsible for freeing the returned SCurve. The 
+// fitting of the stream continues, and the first control point of 
+// the next emitted segment is the last one of the returned SCurve
+SCurve* SCurveFitterDrain(SCurveFitter* const that);
+
+// Append the fitting of the points remaining in the window of the 
+// SCurveFitter 'that' to its SCurve, and return this SCurve
+// The user becomes responsible for freeing the returned SCurve, and 
+// 'that' is reset to start fitting a new stream
+// Return NULL if less than 2 points have been given to 'that' since 
+// the last call to SCurveFitterDrain or SCurveFitterFlush
+SCurve* SCurveFitterFlush(SCurveFitter* const that);
+
+// Get the SCurve made of the segments emitted by the SCurveFitter 
+// 'that' since the last call to SCurveFitterDrain or 
+// SCurveFitterFlush, NULL if there is none
+#if BUILDMODE != 0
+static inline
+#endif 
+const SCurve* SCurveFitterCurve(const SCurveFitter* const that);
+
+// Get the number of points in the window of the SCurveFitter 'that'
+#if BUILDMODE != 0
+static inline
+#endif 
+int SCurveFitterGetNbPoint(const SCurveFitter* const that);
+
+// Restart the window of the SCurveFitter 'that' with the point 
+// 'point' as its first point
+void _SCurveFitterRestart(SCurveFitter* const that, 
+  const VecFloat* const point);
+
+// Add the point 'point' at the end of the window of the SCurveFitter
+// 'that' and update the moments of the window
+void _SCurveFitterAccumulate(SCurveFitter* const that, 
+  const VecFloat* const point);
+
+// Fit the points in the window of the SCurveFitter 'that' with the 
+// control points 'ctrl'
+// Return true if the sum of the squared distances between the points 
+// and the fitted segment is below the square of the tolerance of 
+// 'that'
+bool _SCurveFitterFit(SCurveFitter* const that, VecFloat** const ctrl);
+
+// Append the segment with control points 'ctrl' at the end of the 
+// SCurve of the SCurveFitter 'that'
+void _SCurveFitterEmit(SCurveFitter* const that, 
+  VecFloat* const* const ctrl);
+
 // -------------- BBody
 
 // ================= Data structure ===================
@@ -605,6 +1737,12 @@ typedef struct BBody {
   // they are ordered as follow: 
   // (0,0,0),(0,0,1),...,(0,0,order+1),(0,1,0),(0,1,1),...
   VecFloat** _ctrl;
+  // Cached bounding boxes of the control points and tight bounding 
+  // box (cf BBodyGetBound), and cached center
+  // NULL if they haven't been calculated yet or have been invalidated
+  float* _bound;
+  float* _tightBound;
+  VecFloat* _center;
 } BBody;
 
 // ================ Functions declaration ====================
@@ -627,6 +1765,63 @@ void _BBodySetCtrl(BBody* const that, const VecShort* const iCtrl,
 // u can extend beyond [0.0, 1.0]
 VecFloat* _BBodyGet(const BBody* const that, const VecFloat* const u);
 
+// Get the value of the BBody 'that' at parameter 'u' with the 
+// evaluation specialized for orders 1 to 3 and input dimensions 2 
+// and 3, and add it to 'res' which must be a null vector of dimension 
+// equal to the output dimension
+// Return true if there is such a specialization, false else (and 
+// 'res' is left unchanged)
+#if BUILDMODE != 0
+static inline
+#endif 
+bool _BBodyGetSpecialized(const BBody* const that, 
+  const VecFloat* const u, VecFloat* const res);
+
+// Get the value of the BBody 'that' at parameter 'u' (array of as many
+// floats as inputs) and store it in 'res' (array of as many floats as
+// outputs)
+// The control points are contracted one input at a time with the 
+// weights of this input, using 'scratch' (array of at least 
+// BBodyGetNbScratch(that) floats allocated by the user) as working 
+// memory
+// No memory allocation occurs
+void BBodyGetVal(const BBody* const that, const float* const u, 
+  float* const res, float* const scratch);
+
+// Get the number of floats of the working memory needed by 
+// BBodyGetVal for the BBody 'that'
+#if BUILDMODE != 0
+static inline
+#endif 
+long BBodyGetNbScratch(const BBody* const that);
+
+// Get the values of the BBody 'that' on the grid of parameters whose 
+// values for the 'iInp'-th input are the 'nbSample'['iInp'] floats 
+// 'u'['iInp'] and store them in 'res', allocated by the user with 
+// (product of 'nbSample') * (output dimension) floats
+// The values are stored one after the other, the last input varying 
+// the fastest
+// The weights of each input are calculated once per sample, and the 
+// control points are contracted one input at a time, for a cost of
+// O(size of the grid * (order + 1)) per output dimension
+// If 'that' has 2 inputs and 'tri' is not null, the indices in 'res' 
+// of the vertices of the triangles covering the grid are stored in 
+// 'tri', allocated by the user with at least 
+// 6 * ('nbSample'[0] - 1) * ('nbSample'[1] - 1) ints
+void BBodyGetGrid(const BBody* const that, const int* const nbSample,
+  const float* const* const u, float* const res, int* const tri);
+
+// Contract the tensor 'in' of dimensions 'nbOuter' x 'nbCtrl' x 
+// 'nbInner' along its second dimension with the weights 'w' of 
+// 'nbSample' x 'nbCtrl' floats, and store the result in 'out' of 
+// dimensions 'nbOuter' x 'nbSample' x 'nbInner'
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BBodyContract(const float* const in, const long nbOuter, 
+  const int nbCtrl, const long nbInner, const float* const w, 
+  const int nbSample, float* const out);
+
 // Get the number of control points of the BBody 'that'
 #if BUILDMODE != 0
 static inline
@@ -690,11 +1885,21 @@ bool BBodySave(const BBody* const that, FILE* const stream,
   const bool compact);
 
 // Return the center of the BBody (average of control points)
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
 #if BUILDMODE != 0
 static inline
 #endif 
 VecFloat* BBodyGetCenter(const BBody* const that);
 
+// Free the cached data of the BBody 'that'
+// Must be called each time the control points of the BBody are 
+// modified
+#if BUILDMODE != 0
+static inline
+#endif 
+void _BBodyInvalidateCache(BBody* const that);
+
 // Translate the BBody by 'v'
 #if BUILDMODE != 0
 static inline
@@ -748,6 +1953,25 @@ void _BBodyScaleCenterScalar(BBody* const that, const float c);
 // system.
 Facoid* BBodyGetBoundingBox(const BBody* const that);
 
+// Get the tight bounding box of the BBody, calculated by subdivision
+// of the body instead of from its control points, with a tolerance 
+// of BCURVE_BOUNDEPS relative to the bounding box of the control 
+// points
+// Return a Facoid whose axis are aligned on the standard coordinate 
+// system.
+Facoid* BBodyGetTightBoundingBox(const BBody* const that);
+
+// Get the bounding box of the BBody 'that' and store it in the array
+// 'res' allocated by the user with 2 * _dim[1] floats (minimum values
+// followed by maximum values)
+// If 'tight' is true the bounding box of the body is calculated (cf 
+// BBodyGetTightBoundingBox), else the one of its control points
+// The bounding box is cached until the BBody is modified
+// Not thread-safe: the first call after a modification of 'that' 
+// fills a cache of 'that' through the const pointer
+void BBodyGetBound(const BBody* const that, const bool tight, 
+  float* const res);
+
 // Rotate the BBody by 'theta' relatively to the origin
 // of the coordinates system around 'axis'
 // dim[1] of BBody must be 3
@@ -855,6 +2079,8 @@ void BBodyRotZStart(BBody* const that, const float theta);
 // If 'bias' is not null, it is set to the average of the biases from
 // the least square regression on each output
 // 'order' must be > 0
+// The whole regression matrix is created in memory, cf BBodyFitter
+// for large point clouds
 BBody* BBodyFromPointCloud(
             const int order,
   const GSetVecFloat* inputs,
@@ -868,6 +2094,77 @@ VecFloat* BBodyGetWeightCtrlPt(
      const BBody* that,
   const VecFloat* inputs);
 
+// -------------- BBodyFitter
+
+// ================= Data structure ===================
+
+// Least square fitting of a BBody on a point cloud given point by 
+// point or by chunks
+// The normal equations X^t.X.beta = X^t.Y of the regression are 
+// accumulated point by point, so the memory used is independent of 
+// the number of points, and solved once when the BBody is requested
+typedef struct BBodyFitter {
+  // Order of the fitted BBody
+  int _order;
+  // Dimensions of the inputs and outputs of the fitted BBody
+  VecShort2D _dim;
+  // Number of control points of the fitted BBody
+  int _nbCtrl;
+  // Number of points accumulated
+  long _nbPoint;
+  // Upper half of X^t.X, row by row, _xtx[i * _nbCtrl + j - i] being 
+  // the element (i, j) for j >= i
+  double* _xtx;
+  // X^t.Y, one row of outputs per control point
+  double* _xty;
+  // Y^t.Y per output
+  double* _yty;
+  // Working memory for the weights of the control points of one point
+  // and the weights per input
+  float* _weight;
+  float* _weightInp;
+} BBodyFitter;
+
+// ================ Functions declaration ====================
+
+// Create a new BBodyFitter for a BBody of order 'order' and dimensions
+// 'dim' (inputs and outputs)
+// 'order' must be > 0
+BBodyFitter* BBodyFitterCreate(const int order, 
+  const VecShort2D* const dim);
+
+// Free the memory used by the BBodyFitter 'that'
+void BBodyFitterFree(BBodyFitter** that);
+
+// Add the point of inputs 'input' and outputs 'output' (arrays of 
+// floats of the dimensions of the BBodyFitter 'that') to the point 
+// cloud of 'that'
+// 'input' expected in [0.0, 1.0] but may be out of range
+void BBodyFitterAdd(BBodyFitter* const that, const float* const input, 
+  const float* const output);
+
+// Add the 'nbPoint' points of inputs 'inputs' and outputs 'outputs' 
+// (arrays of 'nbPoint' times the dimensions of the BBodyFitter 'that'
+// floats, stored point after point) to the point cloud of 'that'
+void BBodyFitterAddChunk(BBodyFitter* const that, const long nbPoint,
+  const float* const inputs, const float* const outputs);
+
+// Create a new BBody which approximates best, according to least 
+// square regression, the points added so far to the BBodyFitter 'that'
+// More points can be added to 'that' afterward
+// Return NULL if it couldn't find the BBody (the regression failed)
+// If 'bias' is not null, it is set to the average over the outputs of
+// the norm of the residuals of the regression, as in 
+// BBodyFromPointCloud
+BBody* BBodyFitterSolve(const BBodyFitter* const that, 
+  float* const bias);
+
+// Get the number of points added to the BBodyFitter 'that'
+#if BUILDMODE != 0
+static inline
+#endif 
+long BBodyFitterGetNbPoint(const BBodyFitter* const that);
+
 // ================= Polymorphism ==================
 
 #define BCurveTranslate(Curve, Vec) _Generic(Vec, \
@@ -58,6 +58,81 @@ void UnitTestBCurveCreateCloneFree() {
   printf("UnitTestBCurveCreateCloneFree OK\n");
 }
 
+void UnitTestBCurveCreatePacked() {
+  int order = 3;
+  int dim = 3;
+  BCurve* curve = BCurveCreate(order, dim);
+  BCurve* packed = BCurveCreatePacked(order, dim);
+  if (BCurveIsPacked(curve) == true || BCurveIsPacked(packed) == false ||
+    packed->_dim != dim || packed->_order != order) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BCurveCreatePacked failed");
+    PBErrCatch(BCurveErr);
+  }
+  VecFloat* v = VecFloatCreate(dim);
+  for (int iCtrl = order + 1; iCtrl--;) {
+    if (VecGetDim(BCurveCtrl(packed, iCtrl)) != dim ||
+      VecNorm(BCurveCtrl(packed, iCtrl)) > PBMATH_EPSILON) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "BCurveCreatePacked failed");
+      PBErrCatch(BCurveErr);
+    }
+    for (int iDim = dim; iDim--;)
+      VecSet(v, iDim, iCtrl * dim + iDim);
+    BCurveSetCtrl(curve, iCtrl, v);
+    BCurveSetCtrl(packed, iCtrl, v);
+  }
+  long stride = (char*)BCurveCtrl(packed, 1) - 
+    (char*)BCurveCtrl(packed, 0);
+  if ((char*)(packed->_ctrl) != (char*)packed + sizeof(BCurve) ||
+    (char*)BCurveCtrl(packed, 0) != 
+    (char*)(packed->_ctrl + order + 1) ||
+    (char*)BCurveCtrl(packed, order) - (char*)BCurveCtrl(packed, 0) != 
+    stride * order) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BCurveCreatePacked failed");
+    PBErrCatch(BCurveErr);
+  }
+  for (float u = 0.0; u < 1.0 + PBMATH_EPSILON; u += 0.1) {
+    VecFloat* w = BCurveGet(curve, u);
+    VecFloat* x = BCurveGet(packed, u);
+    if (VecIsEqual(w, x) == false) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "BCurveCreatePacked failed");
+      PBErrCatch(BCurveErr);
+    }
+    VecFree(&w);
+    VecFree(&x);
+  }
+  BCurve* clone = BCurveClone(packed);
+  JSONNode* json = BCurveEncodeAsJSON(curve);
+  BCurve* load = BCurveCreatePacked(1, 1);
+  if (BCurveIsPacked(clone) == false ||
+    BCurveDecodeAsJSON(&load, json) == false ||
+    BCurveIsPacked(load) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BCurveCreatePacked failed");
+    PBErrCatch(BCurveErr);
+  }
+  for (int iCtrl = order + 1; iCtrl--;) {
+    if (VecIsEqual(BCurveCtrl(clone, iCtrl), 
+      BCurveCtrl(curve, iCtrl)) == false ||
+      VecIsEqual(BCurveCtrl(load, iCtrl), 
+      BCurveCtrl(curve, iCtrl)) == false) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "BCurveCreatePacked failed");
+      PBErrCatch(BCurveErr);
+    }
+  }
+  JSONFree(&json);
+  BCurveFree(&curve);
+  BCurveFree(&packed);
+  BCurveFree(&clone);
+  BCurveFree(&load);
+  VecFree(&v);
+  printf("UnitTestBCurveCreatePacked OK\n");
+}
+
 void UnitTestBCurveLoadSavePrint() {
   int order = 3;
   int dim = 2;
@@ -162,6 +237,268 @@ void UnitTestBCurveGet() {
   printf("UnitTestBCurveGet OK\n");
 }
 
+void UnitTestBCurveGetBatch() {
+  int dim = 2;
+  VecFloat* v = VecFloatCreate(dim);
+  // Use enough parameters to go through the vectorized kernel and
+  // the scalar loop for the remaining ones
+  int nbU = 2 * BCURVE_NBLANE + 5;
+  float u[2 * BCURVE_NBLANE + 5];
+  for (int iU = nbU; iU--;)
+    u[iU] = -0.1 + 1.2 * (float)iU / (float)nbU;
+  float resAos[(2 * BCURVE_NBLANE + 5) * 2];
+  float resSoa[(2 * BCURVE_NBLANE + 5) * 2];
+  for (int order = 0; order < 6; ++order) {
+    BCurve* curve = BCurveCreate(order, dim);
+    for (int iCtrl = order + 1; iCtrl--;) {
+      for (int iDim = dim; iDim--;)
+        VecSet(v, iDim, iCtrl * iCtrl * dim + iDim - 3.0 * iCtrl);
+      BCurveSetCtrl(curve, iCtrl, v);
+    }
+    BCurveGetBatch(curve, nbU, u, resAos, false);
+    BCurveGetBatch(curve, nbU, u, resSoa, true);
+    for (int iU = nbU; iU--;) {
+      for (int iDim = dim; iDim--;) {
+        // Reference value by De Casteljau's algorithm in double
+        double p[6];
+        for (int iCtrl = order + 1; iCtrl--;)
+          p[iCtrl] = BCurveCtrlGet(curve, iCtrl, iDim);
+        for (int k = order; k > 0; --k)
+          for (int iCtrl = 0; iCtrl < k; ++iCtrl)
+            p[iCtrl] = (1.0 - u[iU]) * p[iCtrl] + u[iU] * p[iCtrl + 1];
+        double tol = 1e-5 * (1.0 + fabs(p[0]));
+        if (fabs(p[0] - resAos[iU * dim + iDim]) > tol ||
+          fabs(p[0] - resSoa[iDim * nbU + iU]) > tol) {
+          BCurveErr->_type = PBErrTypeUnitTestFailed;
+          sprintf(BCurveErr->_msg, "BCurveGetBatch failed");
+          PBErrCatch(BCurveErr);
+        }
+      }
+    }
+    BCurveFree(&curve);
+  }
+  VecFree(&v);
+  printf("UnitTestBCurveGetBatch OK\n");
+}
+
+void UnitTestBCurveGetSpecialized() {
+  float binom[4][4] = {
+    {1.0, 0.0, 0.0, 0.0}, {1.0, 1.0, 0.0, 0.0},
+    {1.0, 2.0, 1.0, 0.0}, {1.0, 3.0, 3.0, 1.0}};
+  for (int order = 1; order <= 3; ++order) {
+    for (int dim = 2; dim <= 3; ++dim) {
+      BCurve* curve = BCurveCreate(order, dim);
+      for (int iCtrl = order + 1; iCtrl--;)
+        for (int iDim = dim; iDim--;)
+          VecSet(curve->_ctrl[iCtrl], iDim, 
+            (float)(iCtrl * iCtrl) - 0.5 * (float)iDim);
+      for (float u = -0.2; u < 1.2 + PBMATH_EPSILON; u += 0.1) {
+        float res[6] = {0.0};
+        if (_BCurveGetSpecialized(curve, u, res, 2) == false) {
+          BCurveErr->_type = PBErrTypeUnitTestFailed;
+          sprintf(BCurveErr->_msg, "_BCurveGetSpecialized failed");
+          PBErrCatch(BCurveErr);
+        }
+        VecFloat* w = BCurveGetWeightCtrlPt(curve, u);
+        for (int iDim = dim; iDim--;) {
+          float check = 0.0;
+          for (int iCtrl = order + 1; iCtrl--;) {
+            float weight = binom[order][iCtrl] * 
+              powf(u, iCtrl) * powf(1.0 - u, order - iCtrl);
+            check += weight * VecGet(curve->_ctrl[iCtrl], iDim);
+            if (ISEQUALF(VecGet(w, iCtrl), weight) == false) {
+              BCurveErr->_type = PBErrTypeUnitTestFailed;
+              sprintf(BCurveErr->_msg, 
+                "BCurveGetWeightCtrlPt failed");
+              PBErrCatch(BCurveErr);
+            }
+          }
+          if (ISEQUALF(res[iDim * 2], check) == false) {
+            BCurveErr->_type = PBErrTypeUnitTestFailed;
+            sprintf(BCurveErr->_msg, "_BCurveGetSpecialized failed");
+            PBErrCatch(BCurveErr);
+          }
+        }
+        VecFree(&w);
+      }
+      BCurveFree(&curve);
+    }
+  }
+  BCurve* curve = BCurveCreate(4, 2);
+  float res[2] = {0.0};
+  if (_BCurveGetSpecialized(curve, 0.5, res, 1) == true) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "_BCurveGetSpecialized failed");
+    PBErrCatch(BCurveErr);
+  }
+  BCurveFree(&curve);
+  printf("UnitTestBCurveGetSpecialized OK\n");
+}
+
+void UnitTestBCurvePowerBasis() {
+  int order = 3;
+  int dim = 3;
+  BCurve* curve = BCurveCreatePacked(order, dim);
+  for (int iCtrl = order + 1; iCtrl--;)
+    for (int iDim = dim; iDim--;)
+      VecSet(curve->_ctrl[iCtrl], iDim, 
+        (float)(iCtrl * iCtrl) - 0.5 * (float)(iDim * iCtrl));
+  BCurve* check = BCurveClone(curve);
+  if (BCurveGetUsePowerBasis(curve) == true) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BCurveGetUsePowerBasis failed");
+    PBErrCatch(BCurveErr);
+  }
+  BCurveSetUsePowerBasis(curve, true);
+  if (BCurveGetUsePowerBasis(curve) == false || 
+    curve->_powerBasis != NULL) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BCurveSetUsePowerBasis failed");
+    PBErrCatch(BCurveErr);
+  }
+  VecFloat* v = VecFloatCreate(dim);
+  for (int iStep = 0; iStep < 4; ++iStep) {
+    // Modify the curve between each check to test the invalidation 
+    // of the cache
+    if (iStep == 1) {
+      VecSet(v, 0, 1.0); VecSet(v, 1, -2.0); VecSet(v, 2, 3.0);
+      BCurveSetCtrl(curve, 2, v);
+      BCurveSetCtrl(check, 2, v);
+    } else if (iStep == 2) {
+      BCurveTranslate(curve, v);
+      BCurveTranslate(check, v);
+    } else if (iStep == 3) {
+      BCurveScaleCenter(curve, (float)2.0);
+      BCurveScaleCenter(check, (float)2.0);
+    }
+    for (float u = -0.5; u < 1.5 + PBMATH_EPSILON; u += 0.1) {
+      VecFloat* w = BCurveGet(curve, u);
+      if (curve->_powerBasis == NULL) {
+        BCurveErr->_type = PBErrTypeUnitTestFailed;
+        sprintf(BCurveErr->_msg, "_BCurveUpdatePowerBasis failed");
+        PBErrCatch(BCurveErr);
+      }
+      VecFloat* x = BCurveGet(check, u);
+      for (int iDim = dim; iDim--;) {
+        if (fabs(VecGet(w, iDim) - VecGet(x, iDim)) > 0.0001) {
+          BCurveErr->_type = PBErrTypeUnitTestFailed;
+          sprintf(BCurveErr->_msg, "BCurveSetUsePowerBasis failed");
+          PBErrCatch(BCurveErr);
+        }
+      }
+      VecFree(&w);
+      VecFree(&x);
+    }
+  }
+  JSONNode* json = BCurveEncodeAsJSON(check);
+  if (BCurveDecodeAsJSON(&curve, json) == false ||
+    BCurveGetUsePowerBasis(curve) == false ||
+    curve->_powerBasis != NULL) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BCurveSetUsePowerBasis failed");
+    PBErrCatch(BCurveErr);
+  }
+  BCurveSetUsePowerBasis(curve, false);
+  if (BCurveGetUsePowerBasis(curve) == true) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BCurveSetUsePowerBasis failed");
+    PBErrCatch(BCurveErr);
+  }
+  JSONFree(&json);
+  VecFree(&v);
+  BCurveFree(&curve);
+  BCurveFree(&check);
+  printf("UnitTestBCurvePowerBasis OK\n");
+}
+
+void UnitTestBCurveTessellate() {
+  int order = 3;
+  int dim = 3;
+  BCurve* curve = BCurveCreate(order, dim);
+  for (int iCtrl = order + 1; iCtrl--;)
+    for (int iDim = dim; iDim--;)
+      VecSet(curve->_ctrl[iCtrl], iDim, 
+        (float)(iCtrl * iCtrl) - 0.5 * (float)(iDim * iCtrl));
+  long nbPoint = 3 * BCURVE_FDANCHOR + 10;
+  float* res = PBErrMalloc(BCurveErr, sizeof(float) * nbPoint * dim);
+  BCurveTessellate(curve, nbPoint, res);
+  for (long iPoint = nbPoint; iPoint--;) {
+    float u = (float)iPoint / (float)(nbPoint - 1);
+    VecFloat* v = BCurveGet(curve, u);
+    for (int iDim = dim; iDim--;) {
+      if (ISEQUALF(VecGet(v, iDim), res[iPoint * dim + iDim]) == false) {
+        BCurveErr->_type = PBErrTypeUnitTestFailed;
+        sprintf(BCurveErr->_msg, "BCurveTessellate failed");
+        PBErrCatch(BCurveErr);
+      }
+    }
+    VecFree(&v);
+  }
+  free(res);
+  BCurveFree(&curve);
+  printf("UnitTestBCurveTessellate OK\n");
+}
+
+void UnitTestBCurveTessellateAdaptiveCount(const float* const point, 
+  void* const data) {
+  (void)point;
+  ++(*(long*)data);
+}
+
+void UnitTestBCurveTessellateAdaptive() {
+  int order = 3;
+  int dim = 2;
+  BCurve* curve = BCurveCreate(order, dim);
+  VecFloat* v = VecFloatCreate(dim);
+  for (int iCtrl = order + 1; iCtrl--;) {
+    VecSet(v, 0, (float)iCtrl);
+    BCurveSetCtrl(curve, iCtrl, v);
+  }
+  float res[2048];
+  long nb = BCurveTessellateAdaptive(curve, 0.01, res, 1024);
+  if (nb != 2 || ISEQUALF(res[2], 3.0) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BCurveTessellateAdaptive failed");
+    PBErrCatch(BCurveErr);
+  }
+  VecSet(v, 0, 1.0);
+  VecSet(v, 1, 2.0);
+  BCurveSetCtrl(curve, 1, v);
+  VecSet(v, 0, 2.0);
+  VecSet(v, 1, -2.0);
+  BCurveSetCtrl(curve, 2, v);
+  VecFree(&v);
+  long nbA = BCurveTessellateAdaptive(curve, 0.01, res, 1024);
+  long nbB = BCurveTessellateAdaptive(curve, 0.0001, res, 1024);
+  long nbC = 0;
+  long nbD = BCurveTessellateAdaptiveFun(curve, 0.0001, 
+    UnitTestBCurveTessellateAdaptiveCount, &nbC);
+  if (nbA <= 2 || nbB <= nbA || nbB > 1024 || nbC != nbB || 
+    nbD != nbB || BCurveTessellateAdaptive(curve, 0.0001, res, 3) != 
+    nbB) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BCurveTessellateAdaptive failed");
+    PBErrCatch(BCurveErr);
+  }
+  BCurveTessellateAdaptive(curve, 0.0001, res, 1024);
+  for (long i = 0; i < nbB; ++i) {
+    VecFloat* check = BCurveGet(curve, res[i * dim] / 3.0);
+    if (i > 0 && res[i * dim] <= res[(i - 1) * dim]) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "BCurveTessellateAdaptive failed");
+      PBErrCatch(BCurveErr);
+    }
+    if (fabs(VecGet(check, 1) - res[i * dim + 1]) > 0.001) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "BCurveTessellateAdaptive failed");
+      PBErrCatch(BCurveErr);
+    }
+    VecFree(&check);
+  }
+  BCurveFree(&curve);
+  printf("UnitTestBCurveTessellateAdaptive OK\n");
+}
+
 void UnitTestBCurveGetOrderDimNbCtrl() {
   int order = 3;
   int dim = 2;
@@ -378,9 +715,119 @@ void UnitTestBCurveFromCloudPoint() {
   VecFree(&vA);
   VecFree(&vB);
   VecFree(&vC);
+  set = GSetVecFloatCreate();
+  float t[6] = {0.0};
+  for (int iPoint = 0; iPoint < 6; ++iPoint) {
+    VecFloat* v = VecFloatCreate(3);
+    VecSet(v, 0, (float)iPoint);
+    VecSet(v, 1, sin((float)iPoint));
+    VecSet(v, 2, cos((float)iPoint));
+    if (iPoint > 0)
+      t[iPoint] = t[iPoint - 1] + VecDist(v, GSetTail(set));
+    GSetAppend(set, v);
+  }
+  cloud = BCurveFromCloudPoint(set);
+  for (int iPoint = 0; iPoint < 6; ++iPoint) {
+    VecFloat* w = BCurveGet(cloud, t[iPoint] / t[5]);
+    if (VecDist(w, GSetGet(set, iPoint)) > 1e-3) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "BCurveFromCloudPoint failed");
+      PBErrCatch(BCurveErr);
+    }
+    VecFree(&w);
+  }
+  BCurveFree(&cloud);
+  VecCopy((VecFloat*)GSetGet(set, 2), (VecFloat*)GSetGet(set, 1));
+  cloud = BCurveFromCloudPoint(set);
+  if (cloud != NULL) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BCurveFromCloudPoint failed");
+    PBErrCatch(BCurveErr);
+  }
+  while (GSetNbElem(set) > 0) {
+    VecFloat* v = GSetPop(set);
+    VecFree(&v);
+  }
+  GSetFree(&set);
   printf("UnitTestBCurveFromCloudPoint OK\n");
 }
 
+void UnitTestBCurveFromCloudPointOrder() {
+  GSetVecFloat* set = GSetVecFloatCreate();
+  int nbPoint = 1000;
+  for (int iPoint = 0; iPoint < nbPoint; ++iPoint) {
+    float theta = PBMATH_HALFPI * (float)iPoint / (float)(nbPoint - 1);
+    VecFloat* v = VecFloatCreate(2);
+    VecSet(v, 0, cos(theta));
+    VecSet(v, 1, sin(theta));
+    GSetAppend(set, v);
+  }
+  BCurve* curve = BCurveFromCloudPointOrder(set, 3);
+  if (curve == NULL || BCurveGetOrder(curve) != 3 ||
+    VecIsEqual(BCurveCtrl(curve, 0), GSetHead(set)) == false ||
+    VecIsEqual(BCurveCtrl(curve, 3), GSetTail(set)) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BCurveFromCloudPointOrder failed");
+    PBErrCatch(BCurveErr);
+  }
+  for (float u = 0.0; u < 1.0 + PBMATH_EPSILON; u += 0.1) {
+    VecFloat* v = BCurveGet(curve, u);
+    if (fabs(VecNorm(v) - 1.0) > 5e-3) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "BCurveFromCloudPointOrder failed");
+      PBErrCatch(BCurveErr);
+    }
+    VecFree(&v);
+  }
+  BCurveFree(&curve);
+  while (GSetNbElem(set) > 0) {
+    VecFloat* v = GSetPop(set);
+    VecFree(&v);
+  }
+  GSetFree(&set);
+  printf("UnitTestBCurveFromCloudPointOrder OK\n");
+}
+
+void UnitTestBCurveSolveSys() {
+  // The singularity of the systems doesn't depend on their scale
+  double scales[2] = {1e-14, 1e6};
+  for (int iScale = 2; iScale--;) {
+    double scale = scales[iScale];
+    double mat[4] = {2.0 * scale, scale, scale, 3.0 * scale};
+    double rhs[2] = {3.0 * scale, 4.0 * scale};
+    if (_BCurveSolveLinSys(mat, 2, rhs, 1) == false ||
+      fabs(rhs[0] - 1.0) > 1e-9 || fabs(rhs[1] - 1.0) > 1e-9) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "_BCurveSolveLinSys failed");
+      PBErrCatch(BCurveErr);
+    }
+    double band[4] = {2.0 * scale, scale, 3.0 * scale, 0.0};
+    rhs[0] = 3.0 * scale;
+    rhs[1] = 4.0 * scale;
+    if (_BCurveSolveBandSys(band, 2, 1, rhs, 1) == false ||
+      fabs(rhs[0] - 1.0) > 1e-9 || fabs(rhs[1] - 1.0) > 1e-9) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "_BCurveSolveBandSys failed");
+      PBErrCatch(BCurveErr);
+    }
+    double singular[4] = {scale, scale, scale, (1.0 + 1e-15) * scale};
+    rhs[0] = scale;
+    rhs[1] = scale;
+    if (_BCurveSolveLinSys(singular, 2, rhs, 1) == true) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "_BCurveSolveLinSys failed");
+      PBErrCatch(BCurveErr);
+    }
+    double singularBand[4] = {scale, scale, (1.0 + 1e-15) * scale, 0.0};
+    if (_BCurveSolveBandSys(singularBand, 2, 1, rhs, 1) == true) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "_BCurveSolveBandSys failed");
+      PBErrCatch(BCurveErr);
+    }
+  }
+  printf("UnitTestBCurveSolveSys OK\n");
+}
+
 void UnitTestBCurveGetWeightCtrlPt() {
   int order = 2;
   int dim = 2;
@@ -450,19 +897,83 @@ void UnitTestBCurveGetBoundingBox() {
   printf("UnitTestBCurveGetBoundingBox OK\n");
 }
 
+void UnitTestBCurveGetTightBoundingBox() {
+  BCurve* curve = BCurveCreate(3, 2);
+  float ctrl[8] = {0.0, 0.0, 1.0, 2.0, 2.0, 2.0, 3.0, 0.0};
+  VecFloat2D v = VecFloatCreateStatic2D();
+  for (int iCtrl = 4; iCtrl--;) {
+    VecSet(&v, 0, ctrl[2 * iCtrl]);
+    VecSet(&v, 1, ctrl[2 * iCtrl + 1]);
+    BCurveSetCtrl(curve, iCtrl, (VecFloat*)&v);
+  }
+  Facoid* bound = BCurveGetTightBoundingBox(curve);
+  if (ISEQUALF(ShapoidPosGet(bound, 0), 0.0) == false ||
+    ISEQUALF(ShapoidPosGet(bound, 1), 0.0) == false ||
+    ISEQUALF(ShapoidAxisGet(bound, 0, 0), 3.0) == false ||
+    ShapoidAxisGet(bound, 1, 1) < 1.5 || 
+    ShapoidAxisGet(bound, 1, 1) > 1.5 + 2.0 * BCURVE_BOUNDEPS * 2.0) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BCurveGetTightBoundingBox failed");
+    PBErrCatch(BCurveErr);
+  }
+  ShapoidFree(&bound);
+  BCurveFree(&curve);
+  curve = BCurveCreate(5, 1);
+  float val[6] = {0.0, 3.0, -2.0, 4.0, -1.0, 1.0};
+  VecFloat* w = VecFloatCreate(1);
+  for (int iCtrl = 6; iCtrl--;) {
+    VecSet(w, 0, val[iCtrl]);
+    BCurveSetCtrl(curve, iCtrl, w);
+  }
+  VecFree(&w);
+  float res[2];
+  BCurveGetBound(curve, false, res);
+  if (ISEQUALF(res[0], -2.0) == false || ISEQUALF(res[1], 4.0) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BCurveGetBound failed");
+    PBErrCatch(BCurveErr);
+  }
+  BCurveGetBound(curve, true, res);
+  float min = 0.0;
+  float max = 0.0;
+  for (int iSample = 10001; iSample--;) {
+    VecFloat* p = BCurveGet(curve, (float)iSample / 10000.0);
+    min = MIN(min, VecGet(p, 0));
+    max = MAX(max, VecGet(p, 0));
+    VecFree(&p);
+  }
+  if (res[0] > min || res[0] < min - 1e-3 || 
+    res[1] < max || res[1] > max + 1e-3) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BCurveGetBound failed");
+    PBErrCatch(BCurveErr);
+  }
+  BCurveFree(&curve);
+  printf("UnitTestBCurveGetTightBoundingBox OK\n");
+}
+
 void UnitTestBCurve() {
   UnitTestBCurveCreateCloneFree();
+  UnitTestBCurveCreatePacked();
   UnitTestBCurveLoadSavePrint();
   UnitTestBCurveGetSetCtrl();
   UnitTestBCurveGet();
+  UnitTestBCurveGetBatch();
+  UnitTestBCurveGetSpecialized();
+  UnitTestBCurvePowerBasis();
+  UnitTestBCurveTessellate();
+  UnitTestBCurveTessellateAdaptive();
   UnitTestBCurveGetOrderDimNbCtrl();
   UnitTestBCurveGetApproxLenCenter();
   UnitTestBCurveRot();
   UnitTestBCurveScale();
   UnitTestBCurveTranslate();
   UnitTestBCurveFromCloudPoint();
+  UnitTestBCurveFromCloudPointOrder();
+  UnitTestBCurveSolveSys();
   UnitTestBCurveGetWeightCtrlPt();
   UnitTestBCurveGetBoundingBox();
+  UnitTestBCurveGetTightBoundingBox();
   printf("UnitTestBCurve OK\n");
 }
 
@@ -743,6 +1254,73 @@ void UnitTestSCurveGetAddRemoveSeg() {
   printf("UnitTestSCurveGetAddRemoveSeg OK\n");
 }
 
+void UnitTestSCurveIndexedAccess() {
+  int order = 2;
+  int dim = 2;
+  SCurve* curve = SCurveCreate(order, dim, 1);
+  for (int i = 0; i < 50; ++i) {
+    if (i % 3 == 0)
+      SCurveAddSegHead(curve);
+    else
+      SCurveAddSegTail(curve);
+    if (i % 7 == 6) {
+      SCurveRemoveHeadSeg(curve);
+      SCurveRemoveTailSeg(curve);
+    }
+  }
+  if (SCurveGetNbSeg(curve) != 37 ||
+    GSetNbElem(SCurveSegs(curve)) != 37 ||
+    GSetNbElem(SCurveCtrls(curve)) != SCurveGetNbCtrl(curve)) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveIndexedAccess failed");
+    PBErrCatch(BCurveErr);
+  }
+  GSetIterForward iter = GSetIterForwardCreateStatic(SCurveSegs(curve));
+  int iSeg = 0;
+  do {
+    if (SCurveSeg(curve, iSeg) != GSetIterGet(&iter) ||
+      BCurveIsPacked(SCurveSeg(curve, iSeg)) == false) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "SCurveIndexedAccess failed");
+      PBErrCatch(BCurveErr);
+    }
+    ++iSeg;
+  } while (GSetIterStep(&iter));
+  iter = GSetIterForwardCreateStatic(SCurveCtrls(curve));
+  int iCtrl = 0;
+  do {
+    if (SCurveCtrl(curve, iCtrl) != GSetIterGet(&iter)) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "SCurveIndexedAccess failed");
+      PBErrCatch(BCurveErr);
+    }
+    ++iCtrl;
+  } while (GSetIterStep(&iter));
+  for (iCtrl = SCurveGetNbCtrl(curve); iCtrl--;)
+    SCurveCtrlSet(curve, iCtrl, 0, iCtrl);
+  for (int i = 0; i < 20; ++i) {
+    SCurveAddSegHead(curve);
+    SCurveAddSegTail(curve);
+  }
+  SCurve* clone = SCurveClone(curve);
+  for (iCtrl = SCurveGetNbCtrl(curve); iCtrl--;) {
+    float check = 0.0;
+    if (iCtrl > 20 * order && iCtrl <= 57 * order)
+      check = iCtrl - 20 * order;
+    if (ISEQUALF(SCurveCtrlGet(curve, iCtrl, 0), check) == false ||
+      ISEQUALF(SCurveCtrlGet(clone, iCtrl, 0), check) == false ||
+      (char*)SCurveCtrl(curve, iCtrl) - (char*)SCurveCtrl(curve, 0) != 
+      (long)(iCtrl * curve->_sizeCtrl)) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "SCurveIndexedAccess failed");
+      PBErrCatch(BCurveErr);
+    }
+  }
+  SCurveFree(&clone);
+  SCurveFree(&curve);
+  printf("UnitTestSCurveIndexedAccess OK\n");
+}
+
 void UnitTestSCurveGet() {
   int order = 3;
   int dim = 2;
@@ -767,6 +1345,66 @@ void UnitTestSCurveGet() {
   printf("UnitTestSCurveGet OK\n");
 }
 
+void UnitTestSCurveGetSegIndex() {
+  int order = 2;
+  int dim = 2;
+  int nbSeg = 3;
+  SCurve* curve = SCurveCreate(order, dim, nbSeg);
+  float u[5] = {-0.5, 0.25, 1.0, 2.5, 3.5};
+  int checkSeg[5] = {0, 0, 1, 2, 2};
+  float checkLoc[5] = {-0.5, 0.25, 0.0, 0.5, 1.5};
+  for (int i = 0; i < 5; ++i) {
+    float uloc = 0.0;
+    int iSeg = SCurveGetSegIndex(curve, u[i], &uloc);
+    if (iSeg != checkSeg[i] || ISEQUALF(uloc, checkLoc[i]) == false) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "SCurveGetSegIndex failed");
+      PBErrCatch(BCurveErr);
+    }
+  }
+  SCurveFree(&curve);
+  printf("UnitTestSCurveGetSegIndex OK\n");
+}
+
+void UnitTestSCurveGetBatch() {
+  int order = 3;
+  int dim = 3;
+  int nbSeg = 4;
+  SCurve* curve = SCurveCreate(order, dim, nbSeg);
+  for (int iCtrl = SCurveGetNbCtrl(curve); iCtrl--;)
+    for (int iDim = dim; iDim--;)
+      SCurveCtrlSet(curve, iCtrl, iDim, 
+        (float)((iCtrl * 7 + iDim * 3) % 11) - 5.0);
+  long nbU = 101;
+  float u[101];
+  float res[303];
+  for (int iSorted = 0; iSorted < 2; ++iSorted) {
+    for (long iU = 0; iU < nbU; ++iU) {
+      if (iSorted == 0)
+        u[iU] = -0.5 + 5.0 * (float)iU / (float)(nbU - 1);
+      else
+        u[iU] = -0.5 + 5.0 * (float)((iU * 37) % nbU) / (float)(nbU - 1);
+    }
+    SCurveGetBatch(curve, nbU, u, res);
+    for (long iU = 0; iU < nbU; ++iU) {
+      VecFloat* check = SCurveGet(curve, u[iU]);
+      for (int iDim = dim; iDim--;) {
+        // The values are equal up to the rounding errors, relative to
+        // their magnitude
+        float tol = 1e-5 * (1.0 + fabs(VecGet(check, iDim)));
+        if (fabs(res[iU * dim + iDim] - VecGet(check, iDim)) > tol) {
+          BCurveErr->_type = PBErrTypeUnitTestFailed;
+          sprintf(BCurveErr->_msg, "SCurveGetBatch failed");
+          PBErrCatch(BCurveErr);
+        }
+      }
+      VecFree(&check);
+    }
+  }
+  SCurveFree(&curve);
+  printf("UnitTestSCurveGetBatch OK\n");
+}
+
 void UnitTestSCurveGetOrderDimNbSegMaxUNbCtrl() {
   int order = 3;
   int dim = 2;
@@ -835,6 +1473,76 @@ void UnitTestSCurveGetApproxLenCenter() {
   printf("UnitTestSCurveGetApproxLenCenter OK\n");
 }
 
+void UnitTestSCurveArcLength() {
+  int order = 3;
+  int dim = 2;
+  int nbSeg = 2;
+  SCurve* curve = SCurveCreate(order, dim, nbSeg);
+  float x[7] = {0.0, 0.1, 0.2, 3.0, 3.5, 5.9, 6.0};
+  for (int iCtrl = SCurveGetNbCtrl(curve); iCtrl--;) {
+    SCurveCtrlSet(curve, iCtrl, 0, x[iCtrl]);
+    SCurveCtrlSet(curve, iCtrl, 1, 2.0 * x[iCtrl]);
+  }
+  float len = sqrt(5.0) * 6.0;
+  if (fabs(SCurveGetLength(curve) - len) > 1e-4) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveGetLength failed");
+    PBErrCatch(BCurveErr);
+  }
+  for (float u = 0.0; u < SCurveGetMaxU(curve) + PBMATH_EPSILON; 
+    u += 0.1) {
+    VecFloat* v = SCurveGet(curve, u);
+    float l = SCurveGetLengthAtParam(curve, u);
+    if (fabs(l - sqrt(5.0) * VecGet(v, 0)) > 1e-4 ||
+      fabs(SCurveGetParamAtLength(curve, l) - u) > 1e-3) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "SCurveGetParamAtLength failed");
+      PBErrCatch(BCurveErr);
+    }
+    VecFree(&v);
+  }
+  SCurveIter iter = SCurveIterCreateStatic(curve, 0.5);
+  SCurveIterSetByLength(&iter, true);
+  if (SCurveIterIsByLength(&iter) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveIterSetByLength failed");
+    PBErrCatch(BCurveErr);
+  }
+  float val[2];
+  int nbStep = 0;
+  do {
+    SCurveIterGetVal(&iter, val);
+    float check = MIN(0.5 * (float)nbStep, len);
+    if (fabs(sqrt(5.0) * val[0] - check) > 1e-3) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "SCurveIterStep by length failed");
+      PBErrCatch(BCurveErr);
+    }
+    ++nbStep;
+  } while (SCurveIterStep(&iter));
+  if (nbStep != 28 || 
+    ISEQUALF(SCurveIterGetPos(&iter), SCurveGetMaxU(curve)) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveIterStep by length failed");
+    PBErrCatch(BCurveErr);
+  }
+  while (SCurveIterStepP(&iter))
+    --nbStep;
+  if (nbStep != 1 || ISEQUALF(SCurveIterGetPos(&iter), 0.0) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveIterStepP by length failed");
+    PBErrCatch(BCurveErr);
+  }
+  SCurveScaleOrigin(curve, (float)2.0);
+  if (fabs(SCurveGetLength(curve) - 2.0 * len) > 1e-4) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveGetLength failed");
+    PBErrCatch(BCurveErr);
+  }
+  SCurveFree(&curve);
+  printf("UnitTestSCurveArcLength OK\n");
+}
+
 void UnitTestSCurveRot() {
   int order = 3;
   int dim = 2;
@@ -1039,19 +1747,109 @@ void UnitTestSCurveGetBoundingBox() {
   Facoid* bound = SCurveGetBoundingBox(curve);
   if (ISEQUALF(ShapoidPosGet(bound, 0), -1.0) == false ||
     ISEQUALF(ShapoidPosGet(bound, 1), -0.382683) == false ||
-    ISEQUALF(ShapoidAxisGet(bound, 0, 0), 2.382684) == false ||
+    ISEQUALF(ShapoidAxisGet(bound, 0, 0), 2.0) == false ||
     ISEQUALF(ShapoidAxisGet(bound, 0, 1), 0.0) == false ||
     ISEQUALF(ShapoidAxisGet(bound, 1, 0), 0.0) == false ||
-    ISEQUALF(ShapoidAxisGet(bound, 1, 1), 1.765367) == false) {
+    ISEQUALF(ShapoidAxisGet(bound, 1, 1), 1.382683) == false) {
     BCurveErr->_type = PBErrTypeUnitTestFailed;
     sprintf(BCurveErr->_msg, "SCurveGetBoundingBox failed");
     PBErrCatch(BCurveErr);
   }
   ShapoidFree(&bound);
+  VecFloat* ctrl = SCurveGetCtrl(curve, 4);
+  VecSet(ctrl, 0, 3.0);
+  VecSet(ctrl, 1, -2.0);
+  SCurveSetCtrl(curve, 4, ctrl);
+  bound = SCurveGetBoundingBox(curve);
+  if (ISEQUALF(ShapoidPosGet(bound, 0), -1.0) == false ||
+    ISEQUALF(ShapoidPosGet(bound, 1), -2.0) == false ||
+    ISEQUALF(ShapoidAxisGet(bound, 0, 0), 4.0) == false ||
+    ISEQUALF(ShapoidAxisGet(bound, 1, 1), 2.923880) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveGetBoundingBox failed");
+    PBErrCatch(BCurveErr);
+  }
+  VecFree(&ctrl);
+  ShapoidFree(&bound);
   SCurveFree(&curve);
   printf("UnitTestSCurveGetBoundingBox OK\n");
 }
 
+void UnitTestSCurveGetTightBoundingBox() {
+  SCurve* curve = SCurveCreate(2, 2, 2);
+  float ctrl[10] = {0.0, 0.0, 1.0, 2.0, 2.0, 0.0, 3.0, -2.0, 4.0, 0.0};
+  for (int iCtrl = 5; iCtrl--;) {
+    SCurveCtrlSet(curve, iCtrl, 0, ctrl[2 * iCtrl]);
+    SCurveCtrlSet(curve, iCtrl, 1, ctrl[2 * iCtrl + 1]);
+  }
+  Facoid* bound = SCurveGetTightBoundingBox(curve);
+  // The range of the curve is widened by BCURVE_BOUNDEPS relative to 
+  // the range of the control points of each segment (2.0), checked 
+  // with a margin for the rounding
+  float tol = 2.0 * 2.0 * BCURVE_BOUNDEPS;
+  if (ISEQUALF(ShapoidPosGet(bound, 0), 0.0) == false ||
+    ShapoidPosGet(bound, 1) > -1.0 || 
+    ShapoidPosGet(bound, 1) < -1.0 - tol ||
+    ISEQUALF(ShapoidAxisGet(bound, 0, 0), 4.0) == false ||
+    ShapoidAxisGet(bound, 1, 1) < 2.0 || 
+    ShapoidAxisGet(bound, 1, 1) > 2.0 + 2.0 * tol) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveGetTightBoundingBox failed");
+    PBErrCatch(BCurveErr);
+  }
+  float res[4];
+  SCurveGetBound(curve, false, res);
+  if (ISEQUALF(res[1], -2.0) == false || 
+    ISEQUALF(res[3], 2.0) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveGetBound failed");
+    PBErrCatch(BCurveErr);
+  }
+  ShapoidFree(&bound);
+  SCurveFree(&curve);
+  printf("UnitTestSCurveGetTightBoundingBox OK\n");
+}
+
+void UnitTestSCurveBoundCache() {
+  SCurve* curve = SCurveCreate(2, 2, 2);
+  for (int iCtrl = 5; iCtrl--;) {
+    SCurveCtrlSet(curve, iCtrl, 0, (float)iCtrl);
+    SCurveCtrlSet(curve, iCtrl, 1, 0.0);
+  }
+  float res[4];
+  SCurveGetBound(curve, false, res);
+  SCurveGetBound(curve, false, res);
+  SCurveCtrlSet(curve, 3, 1, 2.0);
+  SCurveGetBound(curve, false, res);
+  if (ISEQUALF(res[1], 0.0) == false || 
+    ISEQUALF(res[3], 2.0) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveGetBound failed");
+    PBErrCatch(BCurveErr);
+  }
+  VecFloat2D v = VecFloatCreateStatic2D();
+  VecSet(&v, 0, 1.0); VecSet(&v, 1, -1.0);
+  VecFloat* center = SCurveGetCenter(curve);
+  VecFree(&center);
+  SCurveTranslate(curve, &v);
+  SCurveAddSegTail(curve);
+  SCurveCtrlSet(curve, 6, 0, 8.0);
+  SCurveGetBound(curve, false, res);
+  center = SCurveGetCenter(curve);
+  if (ISEQUALF(res[0], 0.0) == false || 
+    ISEQUALF(res[1], -1.0) == false || 
+    ISEQUALF(res[2], 8.0) == false || 
+    ISEQUALF(res[3], 1.0) == false ||
+    ISEQUALF(VecGet(center, 0), 23.0 / 7.0) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveGetBound failed");
+    PBErrCatch(BCurveErr);
+  }
+  VecFree(&center);
+  SCurveFree(&curve);
+  printf("UnitTestSCurveBoundCache OK\n");
+}
+
 void UnitTestSCurveGetNewDim() {
   int order = 3;
   int dim = 3;
@@ -1243,6 +2041,120 @@ ShapoidPrintln(facoid, stdout);
   printf("UnitTestSCurveCreateFromShapoid OK\n");
 }
 
+void UnitTestSCurveCreateFromCloudPoint() {
+  GSetVecFloat* set = GSetVecFloatCreate();
+  int nbPoint = 1000;
+  for (int iPoint = 0; iPoint < nbPoint; ++iPoint) {
+    float theta = PBMATH_TWOPI * (float)iPoint / (float)(nbPoint - 1);
+    VecFloat* v = VecFloatCreate(3);
+    VecSet(v, 0, cos(theta));
+    VecSet(v, 1, sin(theta));
+    VecSet(v, 2, theta);
+    GSetAppend(set, v);
+  }
+  SCurve* curve = SCurveCreateFromCloudPoint(set, 8);
+  if (curve == NULL || SCurveGetNbSeg(curve) != 8 ||
+    SCurveGetOrder(curve) != 3 ||
+    VecIsEqual(SCurveCtrl(curve, 0), GSetHead(set)) == false ||
+    VecIsEqual(SCurveCtrl(curve, 24), GSetTail(set)) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveCreateFromCloudPoint failed");
+    PBErrCatch(BCurveErr);
+  }
+  for (float u = 0.0; u < 8.0; u += 0.1) {
+    VecFloat* v = SCurveGet(curve, u);
+    float r = sqrt(VecGet(v, 0) * VecGet(v, 0) + VecGet(v, 1) * VecGet(v, 1));
+    if (fabs(r - 1.0) > 1e-3) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "SCurveCreateFromCloudPoint failed");
+      PBErrCatch(BCurveErr);
+    }
+    VecFree(&v);
+  }
+  SCurveFree(&curve);
+  while (GSetNbElem(set) > 0) {
+    VecFloat* v = GSetPop(set);
+    VecFree(&v);
+  }
+  GSetFree(&set);
+  printf("UnitTestSCurveCreateFromCloudPoint OK\n");
+}
+
+void UnitTestSCurveFitter() {
+  int nbPoint = 2000;
+  float tolerance = 0.001;
+  SCurveFitter* fitter = SCurveFitterCreate(3, tolerance, 32);
+  float* points = PBErrMalloc(BCurveErr, sizeof(float) * 3 * nbPoint);
+  VecFloat* v = VecFloatCreate(3);
+  for (int iPoint = 0; iPoint < nbPoint; ++iPoint) {
+    float theta = 0.01 * (float)iPoint;
+    points[3 * iPoint] = cos(theta);
+    points[3 * iPoint + 1] = sin(theta);
+    points[3 * iPoint + 2] = 0.1 * theta;
+    for (int iDim = 3; iDim--;)
+      VecSet(v, iDim, points[3 * iPoint + iDim]);
+    SCurveFitterAdd(fitter, v);
+    if (SCurveFitterGetNbPoint(fitter) > 32) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "SCurveFitterAdd failed");
+      PBErrCatch(BCurveErr);
+    }
+  }
+  if (SCurveFitterCurve(fitter) == NULL) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveFitterCurve failed");
+    PBErrCatch(BCurveErr);
+  }
+  SCurve* curve = SCurveFitterFlush(fitter);
+  if (curve == NULL || SCurveFitterCurve(fitter) != NULL ||
+    SCurveFitterGetNbPoint(fitter) != 0 ||
+    SCurveGetNbSeg(curve) < 2 || SCurveGetNbSeg(curve) > nbPoint / 2 ||
+    VecIsEqual(SCurveCtrl(curve, SCurveGetNbCtrl(curve) - 1), v) == 
+    false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveFitterFlush failed");
+    PBErrCatch(BCurveErr);
+  }
+  float* u = PBErrMalloc(BCurveErr, sizeof(float) * nbPoint);
+  float* dist = PBErrMalloc(BCurveErr, sizeof(float) * nbPoint);
+  u[0] = 0.0;
+  SCurveGetClosestBatch(curve, nbPoint, points, true, u, dist);
+  for (int iPoint = nbPoint; iPoint--;) {
+    if (dist[iPoint] > tolerance + PBMATH_EPSILON) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "SCurveFitterAdd failed");
+      PBErrCatch(BCurveErr);
+    }
+  }
+  SCurve* drained = NULL;
+  for (int iPoint = 0; iPoint < nbPoint; ++iPoint) {
+    for (int iDim = 3; iDim--;)
+      VecSet(v, iDim, points[3 * iPoint + iDim]);
+    SCurveFitterAdd(fitter, v);
+    if (iPoint == nbPoint / 2)
+      drained = SCurveFitterDrain(fitter);
+  }
+  SCurve* tail = SCurveFitterFlush(fitter);
+  if (drained == NULL || tail == NULL || 
+    SCurveGetNbSeg(drained) + SCurveGetNbSeg(tail) != 
+    SCurveGetNbSeg(curve) ||
+    VecIsEqual(SCurveCtrl(drained, SCurveGetNbCtrl(drained) - 1), 
+    SCurveCtrl(tail, 0)) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveFitterDrain failed");
+    PBErrCatch(BCurveErr);
+  }
+  free(u);
+  free(dist);
+  free(points);
+  VecFree(&v);
+  SCurveFree(&curve);
+  SCurveFree(&drained);
+  SCurveFree(&tail);
+  SCurveFitterFree(&fitter);
+  printf("UnitTestSCurveFitter OK\n");
+}
+
 void UnitTestSCurveGetDistToCurve() {
   int order = 1;
   int dim = 2;
@@ -1263,11 +2175,393 @@ void UnitTestSCurveGetDistToCurve() {
     sprintf(BCurveErr->_msg, "SCurveGetDistToCurve failed");
     PBErrCatch(BCurveErr);
   }
+  dist = SCurveGetDistToCurveSampled(curveA, curveB, 1000, 0.0);
+  if (ISEQUALF(dist, 2.0) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveGetDistToCurveSampled failed");
+    PBErrCatch(BCurveErr);
+  }
+  dist = SCurveGetDistToCurveSampled(curveA, curveB, 1000, 0.5);
+  if (dist < 0.5 || dist > 1.0) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveGetDistToCurveSampled failed");
+    PBErrCatch(BCurveErr);
+  }
+  // Check the specialized and generic accumulations of the distances
+  // between descriptors, over blocks and remaining samples
+  int nbSample = 2 * BCURVE_NBLANE + 5;
+  float descA[(2 * BCURVE_NBLANE + 5) * 4];
+  float descB[(2 * BCURVE_NBLANE + 5) * 4];
+  for (int d = 1; d <= 4; ++d) {
+    double check = 0.0;
+    for (int i = 0; i < nbSample; ++i) {
+      double d2 = 0.0;
+      for (int iDim = 0; iDim < d; ++iDim) {
+        descA[i * d + iDim] = (float)((i * 7 + iDim * 3) % 11);
+        descB[i * d + iDim] = 0.5 * (float)((i * 5 + iDim) % 13);
+        double e = descA[i * d + iDim] - descB[i * d + iDim];
+        d2 += e * e;
+      }
+      check += sqrt(d2);
+    }
+    dist = SCurveGetDistDescriptors(descA, descB, nbSample, d);
+    if (fabs(dist - check / (double)nbSample) > 1e-4) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "SCurveGetDistDescriptors failed");
+      PBErrCatch(BCurveErr);
+    }
+  }
   SCurveFree(&curveA);
   SCurveFree(&curveB);
   printf("UnitTestSCurveGetDDistToCurve OK\n");
 }
 
+void UnitTestSCurveGetDistMatrix() {
+  int order = 2;
+  int dim = 2;
+  int nbCurve = 37;
+  SCurve* curves[37];
+  for (int iCurve = nbCurve; iCurve--;) {
+    curves[iCurve] = SCurveCreate(order, dim, 1 + iCurve % 3);
+    for (int iCtrl = SCurveGetNbCtrl(curves[iCurve]); iCtrl--;) {
+      SCurveCtrlSet(curves[iCurve], iCtrl, 0, 
+        (float)((iCurve * 3 + iCtrl * 5) % 7));
+      SCurveCtrlSet(curves[iCurve], iCtrl, 1, 
+        (float)((iCurve * 5 + iCtrl * 3) % 11));
+    }
+  }
+  int nbSample = 50;
+  float res[37 * 37];
+  SCurveGetDistMatrix((const SCurve* const*)curves, nbCurve, NULL, 0, 
+    nbSample, 3, res);
+  for (int iA = nbCurve; iA--;) {
+    for (int iB = nbCurve; iB--;) {
+      float check = SCurveGetDistToCurveSampled(curves[iA], curves[iB],
+        nbSample, 0.0);
+      if (fabs(res[iA * nbCurve + iB] - check) > 1e-4) {
+        BCurveErr->_type = PBErrTypeUnitTestFailed;
+        sprintf(BCurveErr->_msg, "SCurveGetDistMatrix failed");
+        PBErrCatch(BCurveErr);
+      }
+    }
+  }
+  int nbA = 3;
+  int nbB = 34;
+  SCurveGetDistMatrix((const SCurve* const*)curves, nbA, 
+    (const SCurve* const*)(curves + nbA), nbB, nbSample, 0, res);
+  for (int iA = nbA; iA--;) {
+    for (int iB = nbB; iB--;) {
+      float check = SCurveGetDistToCurveSampled(curves[iA], 
+        curves[nbA + iB], nbSample, 0.0);
+      if (fabs(res[iA * nbB + iB] - check) > 1e-4) {
+        BCurveErr->_type = PBErrTypeUnitTestFailed;
+        sprintf(BCurveErr->_msg, "SCurveGetDistMatrix failed");
+        PBErrCatch(BCurveErr);
+      }
+    }
+  }
+  for (int iCurve = nbCurve; iCurve--;)
+    SCurveFree(curves + iCurve);
+  printf("UnitTestSCurveGetDistMatrix OK\n");
+}
+
+void UnitTestSCurveBVH() {
+  int order = 1;
+  int dim = 2;
+  int nbSeg = 20;
+  SCurve* curve = SCurveCreate(order, dim, nbSeg);
+  for (int iCtrl = SCurveGetNbCtrl(curve); iCtrl--;) {
+    SCurveCtrlSet(curve, iCtrl, 0, (float)iCtrl);
+    SCurveCtrlSet(curve, iCtrl, 1, (float)(iCtrl % 2));
+  }
+  const SCurveBVH* bvh = SCurveGetBVH(curve);
+  int res[20];
+  float boxMin[2] = {4.5, 0.0};
+  float boxMax[2] = {6.5, 1.0};
+  long nb = SCurveBVHQueryBox(bvh, boxMin, boxMax, res, 20);
+  if (nb != 3 || res[0] != 4 || res[1] != 5 || res[2] != 6) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveBVHQueryBox failed");
+    PBErrCatch(BCurveErr);
+  }
+  nb = SCurveBVHQueryBox(bvh, boxMin, boxMax, res, 1);
+  if (nb != 3 || res[0] != 4) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveBVHQueryBox failed");
+    PBErrCatch(BCurveErr);
+  }
+  float origin[2] = {-1.0, 0.5};
+  float dir[2] = {1.0, 0.0};
+  nb = SCurveBVHQueryRay(bvh, origin, dir, 5.5, res, 20);
+  if (nb != 5 || res[0] != 0 || res[4] != 4) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveBVHQueryRay failed");
+    PBErrCatch(BCurveErr);
+  }
+  float center[2] = {10.5, 3.0};
+  nb = SCurveBVHQueryPoint(bvh, center, 2.0, res, 20);
+  if (nb != 1 || res[0] != 10) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveBVHQueryPoint failed");
+    PBErrCatch(BCurveErr);
+  }
+  SCurveCtrlSet(curve, 0, 0, 100.0);
+  SCurveCtrlSet(curve, 0, 1, 100.0);
+  bvh = SCurveGetBVH(curve);
+  center[0] = 100.0;
+  center[1] = 100.0;
+  nb = SCurveBVHQueryPoint(bvh, center, 0.5, res, 20);
+  if (nb != 1 || res[0] != 0) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveBVHRefit failed");
+    PBErrCatch(BCurveErr);
+  }
+  SCurveAddSegTail(curve);
+  bvh = SCurveGetBVH(curve);
+  if (bvh->_nbSeg != nbSeg + 1 || 
+    SCurveBVHQueryPoint(bvh, center, 0.5, res, 20) != 1) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveBVHRefit failed");
+    PBErrCatch(BCurveErr);
+  }
+  SCurveFree(&curve);
+  printf("UnitTestSCurveBVH OK\n");
+}
+
+void UnitTestSCurveGetClosestBatch() {
+  int order = 3;
+  int dim = 2;
+  int nbSeg = 12;
+  SCurve* curve = SCurveCreate(order, dim, nbSeg);
+  for (int iCtrl = SCurveGetNbCtrl(curve); iCtrl--;) {
+    SCurveCtrlSet(curve, iCtrl, 0, (float)iCtrl * 0.5);
+    SCurveCtrlSet(curve, iCtrl, 1, (float)((iCtrl * 7) % 5));
+  }
+  int nbPoint = 50;
+  float points[100];
+  for (int iPoint = nbPoint; iPoint--;) {
+    points[2 * iPoint] = -1.0 + (float)iPoint * 0.4;
+    points[2 * iPoint + 1] = 2.0 + sin((float)iPoint) * 3.0;
+  }
+  float u[50];
+  float dist[50];
+  float uWarm[50];
+  float distWarm[50];
+  SCurveGetClosestBatch(curve, nbPoint, points, false, u, dist);
+  uWarm[0] = 0.0;
+  SCurveGetClosestBatch(curve, nbPoint, points, true, uWarm, distWarm);
+  int nbSample = 1000;
+  for (int iPoint = nbPoint; iPoint--;) {
+    float check = -1.0;
+    for (int iSample = nbSample * nbSeg + 1; iSample--;) {
+      VecFloat* v = 
+        SCurveGet(curve, (float)iSample / (float)nbSample);
+      float d = sqrt(pow(VecGet(v, 0) - points[2 * iPoint], 2.0) + 
+        pow(VecGet(v, 1) - points[2 * iPoint + 1], 2.0));
+      if (check < 0.0 || d < check)
+        check = d;
+      VecFree(&v);
+    }
+    VecFloat* v = SCurveGet(curve, u[iPoint]);
+    float d = sqrt(pow(VecGet(v, 0) - points[2 * iPoint], 2.0) + 
+      pow(VecGet(v, 1) - points[2 * iPoint + 1], 2.0));
+    VecFree(&v);
+    if (dist[iPoint] > check + 1e-4 || dist[iPoint] < check - 1e-2 ||
+      fabs(d - dist[iPoint]) > 1e-4 || 
+      fabs(distWarm[iPoint] - dist[iPoint]) > 1e-4) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "SCurveGetClosestBatch failed");
+      PBErrCatch(BCurveErr);
+    }
+  }
+  float seed[3] = {NAN, -100.0, 1e6};
+  for (int iSeed = 3; iSeed--;) {
+    uWarm[0] = seed[iSeed];
+    SCurveGetClosestBatch(curve, nbPoint, points, true, uWarm, 
+      distWarm);
+    for (int iPoint = nbPoint; iPoint--;) {
+      if (fabs(distWarm[iPoint] - dist[iPoint]) > 1e-4) {
+        BCurveErr->_type = PBErrTypeUnitTestFailed;
+        sprintf(BCurveErr->_msg, "SCurveGetClosestBatch failed");
+        PBErrCatch(BCurveErr);
+      }
+    }
+  }
+  SCurveFree(&curve);
+  printf("UnitTestSCurveGetClosestBatch OK\n");
+}
+
+void UnitTestSCurveGetIntersections() {
+  SCurve* curveA = SCurveCreate(1, 2, 4);
+  float ctrlA[10] = {0.0, 0.0, 1.0, 2.0, 2.0, 0.0, 3.0, 2.0, 4.0, 0.0};
+  for (int iCtrl = 5; iCtrl--;) {
+    SCurveCtrlSet(curveA, iCtrl, 0, ctrlA[2 * iCtrl]);
+    SCurveCtrlSet(curveA, iCtrl, 1, ctrlA[2 * iCtrl + 1]);
+  }
+  SCurve* curveB = SCurveCreate(1, 2, 1);
+  SCurveCtrlSet(curveB, 0, 0, -1.0);
+  SCurveCtrlSet(curveB, 0, 1, 1.0);
+  SCurveCtrlSet(curveB, 1, 0, 5.0);
+  SCurveCtrlSet(curveB, 1, 1, 1.0);
+  GSetVecFloat* inter = SCurveGetIntersections(curveA, curveB);
+  if (GSetNbElem(inter) != 4) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveGetIntersections failed");
+    PBErrCatch(BCurveErr);
+  }
+  for (int iInter = 0; iInter < 4; ++iInter) {
+    VecFloat* v = GSetGet(inter, iInter);
+    if (fabs(VecGet(v, 0) - (0.5 + (float)iInter)) > 1e-4 ||
+      fabs(VecGet(v, 1) - (1.5 + (float)iInter) / 6.0) > 1e-4) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "SCurveGetIntersections failed");
+      PBErrCatch(BCurveErr);
+    }
+  }
+  while (GSetNbElem(inter) > 0) {
+    VecFloat* v = GSetPop(inter);
+    VecFree(&v);
+  }
+  SCurveCtrlSet(curveA, 2, 0, 2.0);
+  SCurveCtrlSet(curveA, 2, 1, 0.0);
+  SCurveCtrlSet(curveA, 3, 0, 0.0);
+  SCurveCtrlSet(curveA, 3, 1, 2.0);
+  SCurveRemoveTailSeg(curveA);
+  SCurveCtrlSet(curveA, 1, 0, 2.0);
+  GSetFree(&inter);
+  inter = SCurveGetIntersections(curveA, NULL);
+  if (GSetNbElem(inter) != 1) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveGetIntersections failed");
+    PBErrCatch(BCurveErr);
+  }
+  VecFloat* v = GSetPop(inter);
+  if (fabs(VecGet(v, 0) - 0.5) > 1e-4 || fabs(VecGet(v, 1) - 2.5) > 1e-4) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveGetIntersections failed");
+    PBErrCatch(BCurveErr);
+  }
+  VecFree(&v);
+  GSetFree(&inter);
+  SCurve* joint = SCurveCreate(2, 2, 2);
+  float ctrlJoint[10] = 
+    {-1.0, 0.0, -0.5, 0.0, 0.0, 0.0, 0.0, 1.0, -202.0, -400.0};
+  for (int iCtrl = 5; iCtrl--;) {
+    SCurveCtrlSet(joint, iCtrl, 0, ctrlJoint[2 * iCtrl]);
+    SCurveCtrlSet(joint, iCtrl, 1, ctrlJoint[2 * iCtrl + 1]);
+  }
+  inter = SCurveGetIntersections(joint, NULL);
+  if (GSetNbElem(inter) != 1) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveGetIntersections failed");
+    PBErrCatch(BCurveErr);
+  }
+  v = GSetPop(inter);
+  if (fabs(VecGet(v, 0) - 0.995) > 1e-4 || 
+    fabs(VecGet(v, 1) - 1.0 - 2.0 / 402.0) > 1e-4) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveGetIntersections failed");
+    PBErrCatch(BCurveErr);
+  }
+  VecFree(&v);
+  GSetFree(&inter);
+  SCurveFree(&joint);
+  SCurve* loop = SCurveCreate(3, 2, 1);
+  float ctrlLoop[8] = {0.0, 0.0, 4.0, 3.0, -2.0, 3.0, 2.0, 0.0};
+  for (int iCtrl = 4; iCtrl--;) {
+    SCurveCtrlSet(loop, iCtrl, 0, ctrlLoop[2 * iCtrl]);
+    SCurveCtrlSet(loop, iCtrl, 1, ctrlLoop[2 * iCtrl + 1]);
+  }
+  inter = SCurveGetIntersections(loop, loop);
+  if (GSetNbElem(inter) != 1) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveGetIntersections failed");
+    PBErrCatch(BCurveErr);
+  }
+  v = GSetPop(inter);
+  VecFloat* posA = SCurveGet(loop, VecGet(v, 0));
+  VecFloat* posB = SCurveGet(loop, VecGet(v, 1));
+  if (fabs(VecGet(v, 0) + VecGet(v, 1) - 1.0) > 1e-4 ||
+    VecDist(posA, posB) > 1e-4) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveGetIntersections failed");
+    PBErrCatch(BCurveErr);
+  }
+  VecFree(&posA);
+  VecFree(&posB);
+  VecFree(&v);
+  GSetFree(&inter);
+  SCurveFree(&loop);
+  SCurveFree(&curveA);
+  SCurveFree(&curveB);
+  printf("UnitTestSCurveGetIntersections OK\n");
+}
+
+void UnitTestSCurveTessellate() {
+  int order = 2;
+  int dim = 2;
+  int nbSeg = 3;
+  SCurve* curve = SCurveCreate(order, dim, nbSeg);
+  for (int iCtrl = SCurveGetNbCtrl(curve); iCtrl--;) {
+    for (int iDim = dim; iDim--;)
+      SCurveCtrlSet(curve, iCtrl, iDim, 
+        (float)(iCtrl * iCtrl) - (float)(iDim * iCtrl));
+  }
+  long nbPoints[3] = {2, 7, 101};
+  for (int iTest = 0; iTest < 3; ++iTest) {
+    long nbPoint = nbPoints[iTest];
+    float* res = PBErrMalloc(BCurveErr, sizeof(float) * nbPoint * dim);
+    SCurveTessellate(curve, nbPoint, res);
+    for (long iPoint = nbPoint; iPoint--;) {
+      float u = (float)(iPoint * nbSeg) / (float)(nbPoint - 1);
+      VecFloat* v = SCurveGet(curve, u);
+      for (int iDim = dim; iDim--;) {
+        if (ISEQUALF(VecGet(v, iDim), res[iPoint * dim + iDim]) == 
+          false) {
+          BCurveErr->_type = PBErrTypeUnitTestFailed;
+          sprintf(BCurveErr->_msg, "SCurveTessellate failed");
+          PBErrCatch(BCurveErr);
+        }
+      }
+      VecFree(&v);
+    }
+    free(res);
+  }
+  SCurveFree(&curve);
+  printf("UnitTestSCurveTessellate OK\n");
+}
+
+void UnitTestSCurveTessellateAdaptive() {
+  int order = 2;
+  int dim = 2;
+  int nbSeg = 3;
+  SCurve* curve = SCurveCreate(order, dim, nbSeg);
+  for (int iCtrl = SCurveGetNbCtrl(curve); iCtrl--;)
+    SCurveCtrlSet(curve, iCtrl, 0, (float)iCtrl);
+  float res[2048];
+  long nb = SCurveTessellateAdaptive(curve, 0.01, res, 1024);
+  if (nb != nbSeg + 1 || ISEQUALF(res[nbSeg * dim], 6.0) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveTessellateAdaptive failed");
+    PBErrCatch(BCurveErr);
+  }
+  SCurveCtrlSet(curve, 3, 1, 1.0);
+  nb = SCurveTessellateAdaptive(curve, 0.01, res, 1024);
+  long nbCount = 0;
+  long nbFun = SCurveTessellateAdaptiveFun(curve, 0.01, 
+    UnitTestBCurveTessellateAdaptiveCount, &nbCount);
+  if (nb <= nbSeg + 1 || nbFun != nb || nbCount != nb ||
+    SCurveTessellateAdaptive(curve, 0.01, res, 2) != nb ||
+    ISEQUALF(res[0], 0.0) == false || 
+    ISEQUALF(res[(nb - 1) * dim], 6.0) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveTessellateAdaptive failed");
+    PBErrCatch(BCurveErr);
+  }
+  SCurveFree(&curve);
+  printf("UnitTestSCurveTessellateAdaptive OK\n");
+}
+
 void UnitTestSCurveChaikin() {
   int order = 1;
   int dim = 2;
@@ -1305,16 +2599,30 @@ void UnitTestSCurve() {
   UnitTestSCurveLoadSavePrint();
   UnitTestSCurveGetSetCtrl();
   UnitTestSCurveGetAddRemoveSeg();
+  UnitTestSCurveIndexedAccess();
   UnitTestSCurveGet();
+  UnitTestSCurveGetSegIndex();
+  UnitTestSCurveGetBatch();
   UnitTestSCurveGetOrderDimNbSegMaxUNbCtrl();
   UnitTestSCurveGetApproxLenCenter();
+  UnitTestSCurveArcLength();
   UnitTestSCurveRot();
   UnitTestSCurveScale();
   UnitTestSCurveTranslate();
   UnitTestSCurveGetBoundingBox();
+  UnitTestSCurveGetTightBoundingBox();
+  UnitTestSCurveBoundCache();
   UnitTestSCurveGetNewDim();
   UnitTestSCurveCreateFromShapoid();
+  UnitTestSCurveCreateFromCloudPoint();
+  UnitTestSCurveFitter();
   UnitTestSCurveGetDistToCurve();
+  UnitTestSCurveGetDistMatrix();
+  UnitTestSCurveBVH();
+  UnitTestSCurveGetClosestBatch();
+  UnitTestSCurveGetIntersections();
+  UnitTestSCurveTessellate();
+  UnitTestSCurveTessellateAdaptive();
   UnitTestSCurveChaikin();
   printf("UnitTestSCurve OK\n");
 }
@@ -1438,10 +2746,74 @@ void UnitTestSCurveIterStep() {
   printf("UnitTestSCurveStep OK\n");
 }
 
+void UnitTestSCurveIterGetVal() {
+  int order = 3;
+  int dim = 2;
+  int nbSeg = 4;
+  SCurve* curve = SCurveCreate(order, dim, nbSeg);
+  for (int iCtrl = SCurveGetNbCtrl(curve); iCtrl--;) {
+    for (int iDim = dim; iDim--;)
+      SCurveCtrlSet(curve, iCtrl, iDim, 
+        (float)((iCtrl * 5 + iDim * 3) % 7));
+  }
+  SCurveIter iter = SCurveIterCreateStatic(curve, 0.07);
+  float val[2];
+  int nbStep = 0;
+  do {
+    VecFloat* check = SCurveIterGet(&iter);
+    SCurveIterGetVal(&iter, val);
+    if (ISEQUALF(val[0], VecGet(check, 0)) == false ||
+      ISEQUALF(val[1], VecGet(check, 1)) == false) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "SCurveIterGetVal failed");
+      PBErrCatch(BCurveErr);
+    }
+    VecFree(&check);
+    ++nbStep;
+  } while (SCurveIterStep(&iter));
+  do {
+    VecFloat* check = SCurveIterGet(&iter);
+    SCurveIterGetVal(&iter, val);
+    if (ISEQUALF(val[0], VecGet(check, 0)) == false ||
+      ISEQUALF(val[1], VecGet(check, 1)) == false) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "SCurveIterGetVal failed");
+      PBErrCatch(BCurveErr);
+    }
+    VecFree(&check);
+    --nbStep;
+  } while (SCurveIterStepP(&iter));
+  if (nbStep != 0 || ISEQUALF(SCurveIterGetPos(&iter), 0.0) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveIterGetVal failed");
+    PBErrCatch(BCurveErr);
+  }
+  SCurveRemoveTailSeg(curve);
+  while (SCurveIterStep(&iter))
+    SCurveIterGetVal(&iter, val);
+  if (ISEQUALF(SCurveIterGetPos(&iter), SCurveGetMaxU(curve)) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveIterGetVal failed");
+    PBErrCatch(BCurveErr);
+  }
+  SCurveAddSegTail(curve);
+  SCurveAddSegTail(curve);
+  while (SCurveIterStep(&iter))
+    SCurveIterGetVal(&iter, val);
+  if (ISEQUALF(SCurveIterGetPos(&iter), SCurveGetMaxU(curve)) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "SCurveIterGetVal failed");
+    PBErrCatch(BCurveErr);
+  }
+  SCurveFree(&curve);
+  printf("UnitTestSCurveIterGetVal OK\n");
+}
+
 void UnitTestSCurveIter() {
   UnitTestSCurveIterCreate();
   UnitTestSCurveIterSetGet();
   UnitTestSCurveIterStep();
+  UnitTestSCurveIterGetVal();
 
   printf("UnitTestSCurveIter OK\n");
 }
@@ -1563,6 +2935,136 @@ void UnitTestBBodyGet() {
   printf("UnitTestBBodyGet OK\n");
 }
 
+void UnitTestBBodyGetSpecialized() {
+  for (int order = 1; order <= 3; ++order) {
+    for (short dimIn = 2; dimIn <= 3; ++dimIn) {
+      VecShort2D dim = VecShortCreateStatic2D();
+      VecSet(&dim, 0, dimIn); VecSet(&dim, 1, 2);
+      BBody* body = BBodyCreate(order, &dim);
+      for (int iCtrl = BBodyGetNbCtrl(body); iCtrl--;) {
+        VecSet(body->_ctrl[iCtrl], 0, (float)iCtrl);
+        VecSet(body->_ctrl[iCtrl], 1, (float)(iCtrl % 3) - 0.5);
+      }
+      VecFloat* u = VecFloatCreate(dimIn);
+      for (short iInp = dimIn; iInp--;)
+        VecSet(u, iInp, 0.2 + 0.3 * (float)iInp);
+      VecFloat* res = VecFloatCreate(2);
+      if (_BBodyGetSpecialized(body, u, res) == false) {
+        BCurveErr->_type = PBErrTypeUnitTestFailed;
+        sprintf(BCurveErr->_msg, "_BBodyGetSpecialized failed");
+        PBErrCatch(BCurveErr);
+      }
+      VecFloat* weights = BBodyGetWeightCtrlPt(body, u);
+      VecFloat* check = VecFloatCreate(2);
+      for (int iCtrl = BBodyGetNbCtrl(body); iCtrl--;)
+        VecOp(check, 1.0, body->_ctrl[iCtrl], VecGet(weights, iCtrl));
+      if (VecIsEqual(check, res) == false) {
+        BCurveErr->_type = PBErrTypeUnitTestFailed;
+        sprintf(BCurveErr->_msg, "_BBodyGetSpecialized failed");
+        PBErrCatch(BCurveErr);
+      }
+      VecFree(&u);
+      VecFree(&res);
+      VecFree(&weights);
+      VecFree(&check);
+      BBodyFree(&body);
+    }
+  }
+  printf("UnitTestBBodyGetSpecialized OK\n");
+}
+
+void UnitTestBBodyGetVal() {
+  for (int order = 1; order <= 4; ++order) {
+    for (short dimIn = 1; dimIn <= 4; ++dimIn) {
+      VecShort2D dim = VecShortCreateStatic2D();
+      VecSet(&dim, 0, dimIn); VecSet(&dim, 1, 3);
+      BBody* body = BBodyCreate(order, &dim);
+      for (int iCtrl = BBodyGetNbCtrl(body); iCtrl--;) {
+        VecSet(body->_ctrl[iCtrl], 0, (float)iCtrl);
+        VecSet(body->_ctrl[iCtrl], 1, (float)(iCtrl % 3) - 0.5);
+        VecSet(body->_ctrl[iCtrl], 2, (float)((iCtrl * 7) % 5));
+      }
+      VecFloat* u = VecFloatCreate(dimIn);
+      for (short iInp = dimIn; iInp--;)
+        VecSet(u, iInp, 0.2 + 0.3 * (float)iInp);
+      float* scratch = 
+        PBErrMalloc(BCurveErr, sizeof(float) * BBodyGetNbScratch(body));
+      VecFloat* res = VecFloatCreate(3);
+      BBodyGetVal(body, u->_val, res->_val, scratch);
+      VecFloat* weights = BBodyGetWeightCtrlPt(body, u);
+      VecFloat* check = VecFloatCreate(3);
+      for (int iCtrl = BBodyGetNbCtrl(body); iCtrl--;)
+        VecOp(check, 1.0, body->_ctrl[iCtrl], VecGet(weights, iCtrl));
+      if (VecDist(check, res) > 1e-3) {
+        BCurveErr->_type = PBErrTypeUnitTestFailed;
+        sprintf(BCurveErr->_msg, "BBodyGetVal failed");
+        PBErrCatch(BCurveErr);
+      }
+      free(scratch);
+      VecFree(&u);
+      VecFree(&res);
+      VecFree(&weights);
+      VecFree(&check);
+      BBodyFree(&body);
+    }
+  }
+  printf("UnitTestBBodyGetVal OK\n");
+}
+
+void UnitTestBBodyGetGrid() {
+  for (short dimIn = 2; dimIn <= 3; ++dimIn) {
+    VecShort2D dim = VecShortCreateStatic2D();
+    VecSet(&dim, 0, dimIn); VecSet(&dim, 1, 3);
+    BBody* body = BBodyCreate(5 - dimIn, &dim);
+    for (int iCtrl = BBodyGetNbCtrl(body); iCtrl--;) {
+      VecSet(body->_ctrl[iCtrl], 0, (float)iCtrl);
+      VecSet(body->_ctrl[iCtrl], 1, (float)(iCtrl % 3) - 0.5);
+      VecSet(body->_ctrl[iCtrl], 2, (float)((iCtrl * 7) % 5));
+    }
+    int nbSample[3] = {5, 4, 3};
+    float u0[5] = {0.0, 0.25, 0.5, 0.75, 1.0};
+    float u1[4] = {0.0, 0.1, 0.7, 1.0};
+    float u2[3] = {0.2, 0.4, 0.9};
+    const float* u[3] = {u0, u1, u2};
+    float res[5 * 4 * 3 * 3];
+    int tri[6 * 4 * 3];
+    BBodyGetGrid(body, nbSample, u, res, tri);
+    VecFloat* v = VecFloatCreate(dimIn);
+    int iRes = 0;
+    for (int i0 = 0; i0 < 5; ++i0) {
+      for (int i1 = 0; i1 < 4; ++i1) {
+        for (int i2 = 0; i2 < (dimIn == 3 ? 3 : 1); ++i2) {
+          VecSet(v, 0, u0[i0]);
+          VecSet(v, 1, u1[i1]);
+          if (dimIn == 3)
+            VecSet(v, 2, u2[i2]);
+          VecFloat* check = BBodyGet(body, v);
+          for (int iDim = 3; iDim--;) {
+            if (fabs(VecGet(check, iDim) - res[iRes * 3 + iDim]) > 
+              1e-3) {
+              BCurveErr->_type = PBErrTypeUnitTestFailed;
+              sprintf(BCurveErr->_msg, "BBodyGetGrid failed");
+              PBErrCatch(BCurveErr);
+            }
+          }
+          VecFree(&check);
+          ++iRes;
+        }
+      }
+    }
+    if (dimIn == 2 && (tri[0] != 0 || tri[1] != 4 || tri[2] != 1 || 
+      tri[3] != 1 || tri[4] != 4 || tri[5] != 5 || 
+      tri[6 * 4 * 3 - 1] != 19)) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "BBodyGetGrid failed");
+      PBErrCatch(BCurveErr);
+    }
+    VecFree(&v);
+    BBodyFree(&body);
+  }
+  printf("UnitTestBBodyGetGrid OK\n");
+}
+
 void UnitTestBBodyClone() {
   int order = 1;
   VecShort2D dim = VecShortCreateStatic2D();
@@ -1891,6 +3393,68 @@ void UnitTestBBodyGetBoundingBox() {
   printf("UnitTestBBodyGetBoundingBox OK\n");
 }
 
+void UnitTestBBodyGetTightBoundingBox() {
+  int order = 2;
+  VecShort2D dim = VecShortCreateStatic2D();
+  VecSet(&dim, 0, 2); VecSet(&dim, 1, 1);
+  BBody* surf = BBodyCreate(order, &dim);
+  for (int iCtrl = BBodyGetNbCtrl(surf); iCtrl--;)
+    VecSet(surf->_ctrl[iCtrl], 0, (float)((iCtrl * 7) % 5) - 2.0);
+  Facoid* bound = BBodyGetTightBoundingBox(surf);
+  float min = VecGet(surf->_ctrl[0], 0);
+  float max = min;
+  VecFloat2D u = VecFloatCreateStatic2D();
+  for (int i = 101; i--;) {
+    for (int j = 101; j--;) {
+      VecSet(&u, 0, (float)i / 100.0);
+      VecSet(&u, 1, (float)j / 100.0);
+      VecFloat* p = BBodyGet(surf, &u);
+      min = MIN(min, VecGet(p, 0));
+      max = MAX(max, VecGet(p, 0));
+      VecFree(&p);
+    }
+  }
+  float lo = ShapoidPosGet(bound, 0);
+  float hi = lo + ShapoidAxisGet(bound, 0, 0);
+  if (lo > min || lo < min - 1e-2 || hi < max || hi > max + 1e-2) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BBodyGetTightBoundingBox failed");
+    PBErrCatch(BCurveErr);
+  }
+  ShapoidFree(&bound);
+  BBodyFree(&surf);
+  printf("UnitTestBBodyGetTightBoundingBox OK\n");
+}
+
+void UnitTestBBodyBoundCache() {
+  int order = 1;
+  VecShort2D dim = VecShortCreateStatic2D();
+  VecSet(&dim, 0, 2); VecSet(&dim, 1, 1);
+  BBody* surf = BBodyCreate(order, &dim);
+  for (int iCtrl = BBodyGetNbCtrl(surf); iCtrl--;)
+    VecSet(surf->_ctrl[iCtrl], 0, (float)iCtrl);
+  float res[2];
+  BBodyGetBound(surf, false, res);
+  VecFloat* center = BBodyGetCenter(surf);
+  VecFree(&center);
+  VecFloat* v = VecFloatCreate(1);
+  VecSet(v, 0, 2.0);
+  BBodyTranslate(surf, v);
+  BBodyGetBound(surf, false, res);
+  center = BBodyGetCenter(surf);
+  if (ISEQUALF(res[0], 2.0) == false || 
+    ISEQUALF(res[1], 5.0) == false ||
+    ISEQUALF(VecGet(center, 0), 3.5) == false) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BBodyGetBound failed");
+    PBErrCatch(BCurveErr);
+  }
+  VecFree(&center);
+  VecFree(&v);
+  BBodyFree(&surf);
+  printf("UnitTestBBodyBoundCache OK\n");
+}
+
 void UnitTestBBodyRotate() {
   int order = 1;
   VecShort2D dim = VecShortCreateStatic2D();
@@ -2214,10 +3778,83 @@ void UnitTestBBodyFromPointCloud() {
   printf("UnitTestBBodyFromPointCloud OK\n");
 }
 
+void UnitTestBBodyFitter() {
+  GSetVecFloat inputs = GSetVecFloatCreateStatic();
+  GSetVecFloat outputs = GSetVecFloatCreateStatic();
+  int nbPts = 50;
+  float in[100];
+  float out[150];
+  for (int iPt = 0; iPt < nbPts; ++iPt) {
+    VecFloat* input = VecFloatCreate(2);
+    VecSet(input, 0, (float)((iPt * 7) % 10) / 9.0);
+    VecSet(input, 1, (float)((iPt * 3) % 5) / 4.0 + 0.01 * (float)iPt);
+    VecFloat* output = PointCloud(input);
+    VecSet(output, 2, VecGet(output, 2) + 0.05 * (float)(iPt % 3));
+    for (int i = 2; i--;)
+      in[iPt * 2 + i] = VecGet(input, i);
+    for (int i = 3; i--;)
+      out[iPt * 3 + i] = VecGet(output, i);
+    GSetAppend(&inputs, input);
+    GSetAppend(&outputs, output);
+  }
+  int order = 2;
+  VecShort2D dim = VecShortCreateStatic2D();
+  VecSet(&dim, 0, 2); VecSet(&dim, 1, 3);
+  BBodyFitter* fitter = BBodyFitterCreate(order, &dim);
+  BBodyFitterAdd(fitter, in, out);
+  BBodyFitterAddChunk(fitter, nbPts - 1, in + 2, out + 3);
+  if (BBodyFitterGetNbPoint(fitter) != nbPts) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BBodyFitterAddChunk failed");
+    PBErrCatch(BCurveErr);
+  }
+  float bias;
+  float biasCheck;
+  BBody* bbody = BBodyFitterSolve(fitter, &bias);
+  BBody* check = BBodyFromPointCloud(order, &inputs, &outputs, 
+    &biasCheck);
+  if (bbody == NULL || fabs(bias - biasCheck) > 1e-3) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BBodyFitterSolve failed");
+    PBErrCatch(BCurveErr);
+  }
+  for (int iCtrl = BBodyGetNbCtrl(bbody); iCtrl--;) {
+    if (VecDist(bbody->_ctrl[iCtrl], check->_ctrl[iCtrl]) > 1e-2) {
+      BCurveErr->_type = PBErrTypeUnitTestFailed;
+      sprintf(BCurveErr->_msg, "BBodyFitterSolve failed");
+      PBErrCatch(BCurveErr);
+    }
+  }
+  BBodyFree(&bbody);
+  BBodyFree(&check);
+  BBodyFitterFree(&fitter);
+  fitter = BBodyFitterCreate(3, &dim);
+  BBodyFitterAddChunk(fitter, 4, in, out);
+  bbody = BBodyFitterSolve(fitter, NULL);
+  if (bbody != NULL) {
+    BCurveErr->_type = PBErrTypeUnitTestFailed;
+    sprintf(BCurveErr->_msg, "BBodyFitterSolve failed");
+    PBErrCatch(BCurveErr);
+  }
+  BBodyFitterFree(&fitter);
+  while (GSetNbElem(&inputs) > 0) {
+    VecFloat* v = GSetPop(&inputs);
+    VecFree(&v);
+  }
+  while (GSetNbElem(&outputs) > 0) {
+    VecFloat* v = GSetPop(&outputs);
+    VecFree(&v);
+  }
+  printf("UnitTestBBodyFitter OK\n");
+}
+
 void UnitTestBBody() {
   UnitTestBBodyCreateFree();
   UnitTestBBodyGetSet();
   UnitTestBBodyGet();
+  UnitTestBBodyGetSpecialized();
+  UnitTestBBodyGetVal();
+  UnitTestBBodyGetGrid();
   UnitTestBBodyClone();
   UnitTestBBodyPrint();
   UnitTestBBodyLoadSave();
@@ -2225,8 +3862,11 @@ void UnitTestBBody() {
   UnitTestBBodyTranslate();
   UnitTestBBodyScale();
   UnitTestBBodyGetBoundingBox();
+  UnitTestBBodyGetTightBoundingBox();
+  UnitTestBBodyBoundCache();
   UnitTestBBodyRotate();
   UnitTestBBodyFromPointCloud();
+  UnitTestBBodyFitter();
   printf("UnitTestBBody OK\n");
 }
 